@@ -0,0 +1,106 @@
+#include "Archetype.h"
+
+namespace ECS {
+	Archetype::Archetype(const Signature& signature, const std::array<ComponentAllocatorBase*, ECS_MAX_COMPONENTS>& allocators)
+		: signature(signature)
+	{
+		std::fill(column_index.begin(), column_index.end(), null_entity);
+		std::fill(add_edges.begin(), add_edges.end(), nullptr);
+		std::fill(remove_edges.begin(), remove_edges.end(), nullptr);
+
+		std::size_t row_size = sizeof(Entity);
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (signature.test(id)) {
+				column_index[id] = static_cast<ECS_SIZE_TYPE>(columns.size());
+				columns.push_back({ allocators[id], 0, allocators[id]->SizeInBytes() });
+
+				row_size += allocators[id]->SizeInBytes();
+			}
+		}
+
+		chunk_capacity = std::max<ECS_SIZE_TYPE>(1, static_cast<ECS_SIZE_TYPE>(ECS_ARCHETYPE_CHUNK_SIZE / row_size));
+
+		// Lay out the arrays, padding for alignment may push us over the chunk size, so fit fewer rows until it doesn't
+		while (true) {
+			std::size_t offset = chunk_capacity * sizeof(Entity);
+
+			for (Column& column : columns) {
+				// Every array starts on its own cache line, so threads writing different columns never share one
+				std::size_t align = std::max<std::size_t>(ECS_ARCHETYPE_CHUNK_ALIGN, column.allocator->AlignOf());
+
+				chunk_align = std::max(chunk_align, align);
+				offset = (offset + align - 1) / align * align;
+				column.offset = offset;
+				offset += chunk_capacity * column.size;
+			}
+
+			chunk_size_in_bytes = offset;
+
+			if (chunk_size_in_bytes <= ECS_ARCHETYPE_CHUNK_SIZE || chunk_capacity == 1) break;
+
+			--chunk_capacity;
+		}
+	}
+
+	Archetype::~Archetype() {
+		Clear();
+	}
+
+	ECS_SIZE_TYPE Archetype::PushRow(const Entity& entity) {
+		// Last chunk is full (or we have none)
+		if (chunks.empty() || chunks.back().count == chunk_capacity) {
+			ArchetypeChunk chunk;
+			chunk.data = static_cast<std::byte*>(::operator new(chunk_size_in_bytes, std::align_val_t(chunk_align)));
+
+			chunks.push_back(chunk);
+		}
+
+		ArchetypeChunk& chunk = chunks.back();
+		Entities(chunk)[chunk.count] = entity;
+		++chunk.count;
+
+		return size++;
+	}
+
+	Entity Archetype::RemoveRow(const ECS_SIZE_TYPE& row) {
+		ECS_SIZE_TYPE last = size - 1;
+		Entity moved_entity = dead_entity;
+
+		// Move the last row into the hole
+		if (row != last) {
+			for (ECS_SIZE_TYPE column = 0; column < columns.size(); column++) {
+				std::byte* last_location = Get(last, column);
+
+				columns[column].allocator->Assign(Get(row, column), last_location);
+				columns[column].allocator->Delete(last_location);
+			}
+
+			moved_entity = EntityAt(last);
+			EntityAt(row) = moved_entity;
+		}
+
+		--size;
+
+		// Free the last chunk once nothing is left in it
+		if (--chunks.back().count == 0) {
+			::operator delete(chunks.back().data, std::align_val_t(chunk_align));
+			chunks.pop_back();
+		}
+
+		return moved_entity;
+	}
+
+	void Archetype::Clear() {
+		for (ArchetypeChunk& chunk : chunks) {
+			for (const Column& column : columns) {
+				column.allocator->DeleteRange(chunk.data + column.offset, chunk.count);
+			}
+
+			::operator delete(chunk.data, std::align_val_t(chunk_align));
+		}
+
+		chunks.clear();
+		size = 0;
+	}
+}
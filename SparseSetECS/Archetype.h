@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Core.h"
+#include "Entity.h"
+#include "ComponentPool.h"
+
+namespace ECS {
+	// Fixed-size block of memory, holding the entities of one archetype and an array for each of its components (SoA)
+	struct ArchetypeChunk {
+		std::byte* data = nullptr;
+		ECS_SIZE_TYPE count = 0;
+	};
+
+	// Every entity with exactly the same signature, packed into chunks
+	// Rows are numbered across chunks, and every chunk but the last is always full
+	struct Archetype {
+	public:
+		struct Column {
+			ComponentAllocatorBase* allocator = nullptr; // Owned by the registry
+			std::size_t offset = 0; // Where this component's array starts inside a chunk
+			std::size_t size = 0;
+		};
+
+		Signature signature;
+		std::vector<Column> columns; // In order of component id
+		std::array<ECS_SIZE_TYPE, ECS_MAX_COMPONENTS> column_index; // Component id to column, null_entity if we don't have it
+		std::vector<ArchetypeChunk> chunks;
+		ECS_SIZE_TYPE chunk_capacity = 0;
+		std::size_t chunk_size_in_bytes = 0;
+		std::size_t chunk_align = ECS_ARCHETYPE_CHUNK_ALIGN; // Largest of ECS_ARCHETYPE_CHUNK_ALIGN and every column's alignment
+		ECS_SIZE_TYPE size = 0;
+
+		// Archetype with one component more/less than us, filled in the first time that transition happens
+		std::array<Archetype*, ECS_MAX_COMPONENTS> add_edges;
+		std::array<Archetype*, ECS_MAX_COMPONENTS> remove_edges;
+
+		inline ArchetypeChunk& ChunkOf(const ECS_SIZE_TYPE& row) {
+			return chunks[row / chunk_capacity];
+		}
+
+		inline Entity* Entities(const ArchetypeChunk& chunk) {
+			return reinterpret_cast<Entity*>(chunk.data);
+		}
+
+		inline Entity& EntityAt(const ECS_SIZE_TYPE& row) {
+			return Entities(ChunkOf(row))[row % chunk_capacity];
+		}
+
+		// Location of a component by column, without knowing its type
+		inline std::byte* Get(const ECS_SIZE_TYPE& row, const ECS_SIZE_TYPE& column) {
+			const Column& info = columns[column];
+
+			return ChunkOf(row).data + info.offset + (row % chunk_capacity) * info.size;
+		}
+
+		template <typename T>
+		T* Get(const ECS_SIZE_TYPE& row) {
+			return reinterpret_cast<T*>(Get(row, column_index[ComponentAllocator<T>::GetID()]));
+		}
+
+		// Start of the array of T inside chunk
+		template <typename T>
+		T* Array(const ArchetypeChunk& chunk) {
+			return reinterpret_cast<T*>(chunk.data + columns[column_index[ComponentAllocator<T>::GetID()]].offset);
+		}
+
+		// Add a row at the end for this entity, components are left uninitialised
+		ECS_SIZE_TYPE PushRow(const Entity& entity);
+		// Fill row (whose components have already been moved out or destroyed) with the last row
+		// Returns the entity that was moved into row, or dead_entity if row was the last one
+		Entity RemoveRow(const ECS_SIZE_TYPE& row);
+		// Destroy every component and free every chunk
+		void Clear();
+
+		Archetype(const Signature& signature, const std::array<ComponentAllocatorBase*, ECS_MAX_COMPONENTS>& allocators);
+		~Archetype();
+
+		Archetype(const Archetype& other) = delete;
+		Archetype& operator=(const Archetype& other) = delete;
+	};
+}
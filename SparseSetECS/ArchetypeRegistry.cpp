@@ -0,0 +1,161 @@
+#include "ArchetypeRegistry.h"
+
+namespace ECS {
+	Archetype* ArchetypeRegistry::m_GetOrCreateArchetype(const Signature& signature) {
+		auto it = m_Archetypes.find(signature);
+
+		if (it != m_Archetypes.end()) return it->second;
+
+		Archetype* archetype = new Archetype(signature, m_Allocators);
+
+		m_Archetypes.emplace(signature, archetype);
+		m_ArchetypeList.push_back(archetype);
+
+		return archetype;
+	}
+
+	Archetype* ArchetypeRegistry::m_GetAddEdge(Archetype* archetype, const ECS_COMP_ID_TYPE& comp_id) {
+		Archetype*& edge = archetype->add_edges[comp_id];
+
+		// First time anything with this archetype gained this component
+		if (edge == nullptr) {
+			Signature signature = archetype->signature;
+			signature.set(comp_id, true);
+
+			edge = m_GetOrCreateArchetype(signature);
+			// We know the way back too
+			edge->remove_edges[comp_id] = archetype;
+		}
+
+		return edge;
+	}
+
+	Archetype* ArchetypeRegistry::m_GetRemoveEdge(Archetype* archetype, const ECS_COMP_ID_TYPE& comp_id) {
+		Archetype*& edge = archetype->remove_edges[comp_id];
+
+		if (edge == nullptr) {
+			Signature signature = archetype->signature;
+			signature.set(comp_id, false);
+
+			edge = m_GetOrCreateArchetype(signature);
+			edge->add_edges[comp_id] = archetype;
+		}
+
+		return edge;
+	}
+
+	void ArchetypeRegistry::m_MoveEntity(const Entity& entity, Archetype* destination) {
+		EntityLocation& location = m_Locations[GetIdentifier(entity)];
+		Archetype* source = location.archetype;
+
+		ECS_SIZE_TYPE new_row = destination->PushRow(entity);
+
+		for (ECS_SIZE_TYPE column = 0; column < source->columns.size(); column++) {
+			const Archetype::Column& info = source->columns[column];
+			ECS_COMP_ID_TYPE comp_id = info.allocator->GetComponentID();
+			std::byte* location_in_source = source->Get(location.row, column);
+
+			// Carry over the components we keep
+			if (destination->signature.test(comp_id)) {
+				info.allocator->Assign(destination->Get(new_row, destination->column_index[comp_id]), location_in_source);
+			}
+
+			info.allocator->Delete(location_in_source);
+		}
+
+		// Fill the hole we left behind
+		Entity moved_entity = source->RemoveRow(location.row);
+
+		if (moved_entity != dead_entity) {
+			m_Locations[GetIdentifier(moved_entity)].row = location.row;
+		}
+
+		location.archetype = destination;
+		location.row = new_row;
+	}
+
+	ArchetypeRegistry::EntityLocation* ArchetypeRegistry::m_GetLocation(const Entity& entity) {
+		EntityLocation& location = m_Locations[GetIdentifier(entity)];
+
+		// Dead, or an older version of this identifier
+		if (location.archetype == nullptr || location.archetype->EntityAt(location.row) != entity) {
+			return nullptr;
+		}
+
+		return &location;
+	}
+
+	ArchetypeRegistry::ArchetypeRegistry() {
+		std::fill(m_Allocators.begin(), m_Allocators.end(), nullptr);
+
+		m_EmptyArchetype = m_GetOrCreateArchetype(Signature{});
+	}
+
+	ArchetypeRegistry::~ArchetypeRegistry() {
+		// Archetypes destroy their components through the allocators, so they have to go first
+		for (Archetype* archetype : m_ArchetypeList) {
+			delete archetype;
+		}
+
+		for (ComponentAllocatorBase* allocator : m_Allocators) {
+			delete allocator;
+		}
+	}
+
+	[[nodiscard]] Entity ArchetypeRegistry::Create() {
+		Entity entity;
+
+		// Recycle if we can
+		if (!m_FreeEntities.empty()) {
+			entity = m_FreeEntities.back();
+			m_FreeEntities.pop_back();
+		}
+		else {
+			if (m_NextLargestEntity > ECS_ENTITY_MAX) {
+				LogError("Ran out of entities, attempt to free entities so they can be recycled");
+
+				return ECS_ENTITY_MAX;
+			}
+
+			entity = m_NextLargestEntity++;
+		}
+
+		EntityLocation& location = m_Locations[GetIdentifier(entity)];
+		location.archetype = m_EmptyArchetype;
+		location.row = m_EmptyArchetype->PushRow(entity);
+
+		return entity;
+	}
+
+	void ArchetypeRegistry::FreeEntity(const Entity& entity) {
+		EntityLocation* location = m_GetLocation(entity);
+
+		if (location == nullptr) {
+			LogWarn("Entity {} isn't alive, can't free", entity);
+
+			return;
+		}
+
+		Archetype* archetype = location->archetype;
+
+		// Destroy its components
+		for (ECS_SIZE_TYPE column = 0; column < archetype->columns.size(); column++) {
+			archetype->columns[column].allocator->Delete(archetype->Get(location->row, column));
+		}
+
+		Entity moved_entity = archetype->RemoveRow(location->row);
+
+		if (moved_entity != dead_entity) {
+			m_Locations[GetIdentifier(moved_entity)].row = location->row;
+		}
+
+		location->archetype = nullptr;
+		location->row = 0;
+
+		// Increase version so old handles stop working
+		Entity recycled_entity = entity;
+		IncrementVersion(recycled_entity);
+
+		m_FreeEntities.push_back(recycled_entity);
+	}
+}
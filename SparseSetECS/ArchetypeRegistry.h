@@ -0,0 +1,191 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "Archetype.h"
+
+namespace ECS {
+	template <typename... Ts>
+	class ArchetypeView;
+
+	// Alternative to Registry with the same interface, storing entities in archetype chunks instead of per-component pools
+	// Any combination of components iterates linearly, but adding or removing a component moves every component of that entity
+	class ArchetypeRegistry {
+	private:
+		struct EntityLocation {
+			Archetype* archetype = nullptr; // nullptr if entity isn't alive
+			ECS_SIZE_TYPE row = 0;
+		};
+
+		// Use entity identifier as index into this to find where it is stored
+		PagedArray<EntityLocation, ECS_SPARSE_PAGE, ECS_ENTITY_MAX> m_Locations;
+		std::array<ComponentAllocatorBase*, ECS_MAX_COMPONENTS> m_Allocators;
+
+		std::unordered_map<Signature, Archetype*> m_Archetypes;
+		std::vector<Archetype*> m_ArchetypeList; // In order of creation, for queries
+		Archetype* m_EmptyArchetype = nullptr; // Where entities without components live
+
+		Entity m_NextLargestEntity = 0; // The largest value entity we have right now
+		std::vector<Entity> m_FreeEntities; // Freed entities (with their version already bumped) for recycling
+
+		Archetype* m_GetOrCreateArchetype(const Signature& signature);
+		Archetype* m_GetAddEdge(Archetype* archetype, const ECS_COMP_ID_TYPE& comp_id);
+		Archetype* m_GetRemoveEdge(Archetype* archetype, const ECS_COMP_ID_TYPE& comp_id);
+
+		// Move entity (and every component both archetypes have) into destination, destroys components destination doesn't have
+		void m_MoveEntity(const Entity& entity, Archetype* destination);
+
+		// Location of a live entity, or nullptr if it's dead or the handle is stale
+		EntityLocation* m_GetLocation(const Entity& entity);
+
+	public:
+		ArchetypeRegistry();
+		~ArchetypeRegistry();
+
+		ArchetypeRegistry(const ArchetypeRegistry& other) = delete;
+		ArchetypeRegistry& operator=(const ArchetypeRegistry& other) = delete;
+
+		// Get a new entity to use
+		[[nodiscard]] Entity Create();
+
+		// Free up an entity id and all associated components
+		void FreeEntity(const Entity& entity);
+
+		// Amount of archetypes that have ever been needed
+		inline ECS_SIZE_TYPE GetArchetypeCount() const { return static_cast<ECS_SIZE_TYPE>(m_ArchetypeList.size()); }
+
+		// Register a component for future use (archetypes only need to know how to move it)
+		template <typename T> void RegisterComponent() {
+			ECS_COMP_ID_TYPE id = ComponentAllocator<T>::GetID();
+
+			if (m_Allocators[id] != nullptr) {
+				LogWarn("Component {} already registered, ignoring call", typeid(T).name());
+
+				return;
+			}
+
+			m_Allocators[id] = new ComponentAllocator<T>{};
+		}
+
+		template <typename T, typename... Args> void EmplaceComponent(const Entity& entity, Args&&... args) {
+			ECS_COMP_ID_TYPE comp_id = ComponentAllocator<T>::GetID();
+
+			if (m_Allocators[comp_id] == nullptr) { RegisterComponent<T>(); }
+
+			EntityLocation* location = m_GetLocation(entity);
+
+			if (location == nullptr) {
+				LogError("Entity {} isn't alive, can't emplace {}", entity, typeid(T).name());
+
+				return;
+			}
+
+			if (location->archetype->signature.test(comp_id)) {
+				LogError("Entity {} already had component {}; can't push!", entity, typeid(T).name());
+
+				return;
+			}
+
+			m_MoveEntity(entity, m_GetAddEdge(location->archetype, comp_id));
+
+			// Construct directly in the new slot
+			new (location->archetype->Get(location->row, location->archetype->column_index[comp_id])) T(std::forward<Args>(args)...);
+		}
+
+		// Add a new component to an entity
+		template <typename T> void AddComponent(const Entity& entity, T&& comp) {
+			ECS_COMP_ID_TYPE comp_id = ComponentAllocator<T>::GetID();
+
+			if (m_Allocators[comp_id] == nullptr) { RegisterComponent<T>(); }
+
+			EntityLocation* location = m_GetLocation(entity);
+
+			if (location == nullptr) {
+				LogError("Entity {} isn't alive, can't add {}", entity, typeid(T).name());
+
+				return;
+			}
+
+			if (location->archetype->signature.test(comp_id)) {
+				LogError("Entity {} already had component {}; can't push!", entity, typeid(T).name());
+
+				return;
+			}
+
+			m_MoveEntity(entity, m_GetAddEdge(location->archetype, comp_id));
+
+			m_Allocators[comp_id]->Assign(location->archetype->Get(location->row, location->archetype->column_index[comp_id]), reinterpret_cast<std::byte*>(&comp));
+		}
+
+		// Update the value of an already existing component
+		template <typename T> void ReplaceComponent(const Entity& entity, T&& comp) {
+			T* component = GetComponent<T>(entity);
+
+			if (component == nullptr) {
+				LogError("Attempted to replace component {} for entity {}, but entity didn't have component", typeid(T).name(), entity);
+
+				return;
+			}
+
+			*component = std::forward<T>(comp);
+		}
+
+		// Remove component from an entity
+		template <typename T> void RemoveComponent(const Entity& entity) {
+			ECS_COMP_ID_TYPE comp_id = ComponentAllocator<T>::GetID();
+			EntityLocation* location = m_GetLocation(entity);
+
+			if (location == nullptr || !location->archetype->signature.test(comp_id)) {
+				LogWarn("Entity {} doesn't have component {}, can't remove", entity, typeid(T).name());
+
+				return;
+			}
+
+			m_MoveEntity(entity, m_GetRemoveEdge(location->archetype, comp_id));
+		}
+
+		// Get a pointer to a component for an entity, only valid until the next structural change
+		template <typename T> T* GetComponent(const Entity& entity) {
+			EntityLocation* location = m_GetLocation(entity);
+
+			if (location == nullptr || !location->archetype->signature.test(ComponentAllocator<T>::GetID())) {
+				LogError("Attempted to get component {} for entity {}, but entity doesn't have it", typeid(T).name(), entity);
+
+				return nullptr;
+			}
+
+			return location->archetype->Get<T>(location->row);
+		}
+
+		template <typename T>
+		bool HasComponent(const Entity& entity) {
+			EntityLocation* location = m_GetLocation(entity);
+
+			return location != nullptr && location->archetype->signature.test(ComponentAllocator<T>::GetID());
+		}
+
+		template <typename... Ts>
+		bool AnyOf(const Entity& entity) {
+			return (HasComponent<Ts>(entity) || ...);
+		}
+
+		template <typename... Ts>
+		bool AllOf(const Entity& entity) {
+			return (HasComponent<Ts>(entity) && ...);
+		}
+
+		template <typename... Ts>
+		std::tuple<Ts*...> GetComponents(const Entity& entity) {
+			return std::make_tuple<Ts*...>(GetComponent<Ts>(entity)...);
+		}
+
+		// Every entity with at least these components, from whichever archetypes have them
+		template <typename... Ts>
+		ArchetypeView<Ts...> CreateView() {
+			return ArchetypeView<Ts...>(this);
+		}
+
+		template <typename... Ts>
+		friend class ArchetypeView;
+	};
+}
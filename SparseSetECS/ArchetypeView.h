@@ -0,0 +1,126 @@
+#pragma once
+
+#include "ArchetypeRegistry.h"
+
+namespace ECS {
+	// Iterates every archetype that has all of Ts, chunk by chunk
+	// Archetypes created after the view still get picked up, but structural changes while iterating invalidate it
+	template <typename... Ts>
+	class ArchetypeView {
+	private:
+		ArchetypeRegistry* m_Registry;
+		Signature m_Signature;
+
+		inline bool m_Matches(Archetype* archetype) {
+			return (archetype->signature & m_Signature) == m_Signature;
+		}
+
+		using tuple_type = std::tuple<Entity, Ts*...>;
+
+	public:
+		struct Iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = tuple_type;
+			using pointer = value_type*;
+			using reference = value_type&;
+
+		private:
+			ArchetypeView<Ts...>* m_View;
+			std::size_t m_Archetype = 0;
+			ECS_SIZE_TYPE m_Row = 0;
+			value_type m_Current;
+
+			// Skip over archetypes we don't match or have run out of, then grab the current row
+			void m_Settle() {
+				std::vector<Archetype*>& archetypes = m_View->m_Registry->m_ArchetypeList;
+
+				while (m_Archetype < archetypes.size() && (m_Row >= archetypes[m_Archetype]->size || !m_View->m_Matches(archetypes[m_Archetype]))) {
+					++m_Archetype;
+					m_Row = 0;
+				}
+
+				if (m_Archetype < archetypes.size()) {
+					Archetype* archetype = archetypes[m_Archetype];
+
+					m_Current = tuple_type(archetype->EntityAt(m_Row), archetype->template Get<Ts>(m_Row)...);
+				}
+			}
+
+		public:
+			Iterator(ArchetypeView* view, const std::size_t& archetype)
+				: m_View(view), m_Archetype(archetype)
+			{
+				m_Settle();
+			}
+
+			reference operator*() { return m_Current; }
+			pointer operator->() { return &m_Current; }
+
+			Iterator& operator++() {
+				++m_Row;
+
+				m_Settle();
+
+				return *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator tmp = *this;
+				++(*this);
+
+				return tmp;
+			}
+
+			friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_Archetype == b.m_Archetype && a.m_Row == b.m_Row; }
+			friend bool operator!=(const Iterator& a, const Iterator& b) { return !(a == b); }
+		};
+
+		ArchetypeView(ArchetypeRegistry* registry)
+			: m_Registry(registry)
+		{
+			(m_Signature.set(ComponentAllocator<Ts>::GetID(), true), ...);
+		}
+
+		Iterator begin() { return Iterator(this, 0); }
+		Iterator end() { return Iterator(this, m_Registry->m_ArchetypeList.size()); }
+
+		// Call func(count, entities, Ts*...) with the arrays of every matching chunk, fastest way to iterate
+		template <typename Func>
+		void ForEachChunk(Func&& func) {
+			for (Archetype* archetype : m_Registry->m_ArchetypeList) {
+				if (!m_Matches(archetype)) continue;
+
+				for (ArchetypeChunk& chunk : archetype->chunks) {
+					func(chunk.count, archetype->Entities(chunk), archetype->template Array<Ts>(chunk)...);
+				}
+			}
+		}
+
+		// Call func(entity, Ts&...) for every matching entity
+		template <typename Func>
+		void Each(Func&& func) {
+			ForEachChunk([&](ECS_SIZE_TYPE count, Entity* entities, Ts*... arrays) {
+				for (ECS_SIZE_TYPE i = 0; i < count; i++) {
+					func(entities[i], arrays[i]...);
+				}
+			});
+		}
+
+		// Amount of matching entities
+		ECS_SIZE_TYPE size() {
+			ECS_SIZE_TYPE total = 0;
+
+			for (Archetype* archetype : m_Registry->m_ArchetypeList) {
+				if (m_Matches(archetype)) { total += archetype->size; }
+			}
+
+			return total;
+		}
+
+		bool empty() { return size() == 0; }
+
+		friend Iterator;
+	};
+}
@@ -0,0 +1,132 @@
+#include "ColumnarExport.h"
+
+#include <fstream>
+
+namespace ECS {
+	// Everything an exported schema points at, freed by its release callback
+	struct ExportedSchema {
+		std::string name;
+		std::string component_format;
+		ArrowSchema columns[2]{};
+		ArrowSchema* children[2]{};
+	};
+
+	// Everything an exported array points at, besides the pool's own arrays
+	struct ExportedArray {
+		std::vector<std::uint8_t> validity;
+		const void* buffers[1]{};
+		const void* column_buffers[2][2]{};
+		ArrowArray columns[2]{};
+		ArrowArray* children[2]{};
+	};
+
+	// Children belong to their parent's private data, releasing the parent frees them
+	static void s_ReleaseChildSchema(ArrowSchema* schema) { schema->release = nullptr; }
+	static void s_ReleaseChildArray(ArrowArray* array) { array->release = nullptr; }
+
+	static void s_ReleaseSchema(ArrowSchema* schema) {
+		delete static_cast<ExportedSchema*>(schema->private_data);
+
+		schema->release = nullptr;
+	}
+
+	static void s_ReleaseArray(ArrowArray* array) {
+		delete static_cast<ExportedArray*>(array->private_data);
+
+		array->release = nullptr;
+	}
+
+	void ExportColumns(const PoolColumns& columns, const std::string& name, ArrowSchema* schema, ArrowArray* array)
+	{
+		// Tags have nothing to put in a component column
+		int64_t column_count = columns.component_size != 0 ? 2 : 1;
+		int64_t null_count = columns.tombstones;
+
+		ExportedSchema* schema_data = new ExportedSchema();
+		schema_data->name = name;
+		schema_data->component_format = "w:" + std::to_string(columns.component_size);
+
+		const char* column_formats[2] = { "I", schema_data->component_format.c_str() };
+		const char* column_names[2] = { "entity", "component" };
+
+		for (int64_t column = 0; column < column_count; column++) {
+			ArrowSchema& child = schema_data->columns[column];
+
+			child.format = column_formats[column];
+			child.name = column_names[column];
+			child.flags = ARROW_FLAG_NULLABLE;
+			child.release = &s_ReleaseChildSchema;
+
+			schema_data->children[column] = &child;
+		}
+
+		*schema = ArrowSchema{};
+		schema->format = "+s";
+		schema->name = schema_data->name.c_str();
+		schema->flags = ARROW_FLAG_NULLABLE;
+		schema->n_children = column_count;
+		schema->children = schema_data->children;
+		schema->release = &s_ReleaseSchema;
+		schema->private_data = schema_data;
+
+		ExportedArray* array_data = new ExportedArray();
+
+		// Validity bitmap (LSB first), only needed when there are tombstones to mark as null
+		if (null_count != 0) {
+			array_data->validity.assign((columns.size + 7) / 8, 0);
+
+			for (ECS_SIZE_TYPE index = 0; index < columns.size; index++) {
+				if (!IsTombstone(columns.entities[index])) { array_data->validity[index / 8] |= static_cast<std::uint8_t>(1U << (index % 8)); }
+			}
+		}
+
+		const void* validity = null_count != 0 ? array_data->validity.data() : nullptr;
+		const void* column_data[2] = { columns.entities, columns.components };
+
+		array_data->buffers[0] = validity;
+
+		for (int64_t column = 0; column < column_count; column++) {
+			ArrowArray& child = array_data->columns[column];
+
+			array_data->column_buffers[column][0] = validity;
+			array_data->column_buffers[column][1] = column_data[column];
+
+			child.length = columns.size;
+			child.null_count = null_count;
+			child.n_buffers = 2;
+			child.buffers = array_data->column_buffers[column];
+			child.release = &s_ReleaseChildArray;
+
+			array_data->children[column] = &child;
+		}
+
+		*array = ArrowArray{};
+		array->length = columns.size;
+		array->null_count = null_count;
+		array->n_buffers = 1;
+		array->buffers = array_data->buffers;
+		array->n_children = column_count;
+		array->children = array_data->children;
+		array->release = &s_ReleaseArray;
+		array->private_data = array_data;
+	}
+
+	bool WriteColumns(const PoolColumns& columns, const std::string& path)
+	{
+		std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open()) return false;
+
+		std::uint64_t header[3] = { columns.size, columns.component_size, columns.tombstones };
+
+		file.write("ECSCOLS1", 8);
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(columns.entities), static_cast<std::streamsize>(columns.size * sizeof(Entity)));
+
+		if (columns.component_size != 0) {
+			file.write(reinterpret_cast<const char*>(columns.components), static_cast<std::streamsize>(columns.size * columns.component_size));
+		}
+
+		return static_cast<bool>(file);
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+
+#include "Core.h"
+#include "Entity.h"
+
+// Apache Arrow C data interface, an ABI that is the same everywhere (https://arrow.apache.org/docs/format/CDataInterface.html)
+// Guarded so it can be included next to Arrow's own definition
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+	const char* format;
+	const char* name;
+	const char* metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema** children;
+	struct ArrowSchema* dictionary;
+
+	void (*release)(struct ArrowSchema*);
+	void* private_data;
+};
+
+struct ArrowArray {
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void** buffers;
+	struct ArrowArray** children;
+	struct ArrowArray* dictionary;
+
+	void (*release)(struct ArrowArray*);
+	void* private_data;
+};
+
+#endif
+
+namespace ECS {
+	// The arrays of a component pool, as they are in memory
+	struct PoolColumns {
+		const Entity* entities = nullptr;
+		const std::byte* components = nullptr; // nullptr for tags
+		ECS_SIZE_TYPE size = 0; // Including tombstones
+		ECS_SIZE_TYPE tombstones = 0;
+		std::size_t component_size = 0;
+	};
+
+	// Describe columns to Arrow without copying them, as a struct array of
+	//	"entity":	 uint32
+	//	"component": fixed size binary of component_size bytes (the raw component, tags have no column)
+	// Tombstones are null rows, they're the only thing allocated (a validity bitmap)
+	// The consumer owns schema and array, and calls their release callbacks when done
+	void ExportColumns(const PoolColumns& columns, const std::string& name, ArrowSchema* schema, ArrowArray* array);
+
+	// Write columns to a file, as a small header followed by each column's bytes:
+	//	"ECSCOLS1", uint64 rows, uint64 component_size, uint64 tombstones, entities (uint32 each), then components (component_size each)
+	// Tombstones are left in, and can be told apart by IsTombstone on their entity
+	bool WriteColumns(const PoolColumns& columns, const std::string& path);
+}
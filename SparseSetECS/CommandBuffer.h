@@ -0,0 +1,52 @@
+#pragma once
+
+#include <functional>
+
+#include "Registry.h"
+
+namespace ECS {
+	// Records registry operations from a worker thread, to be applied later on the main thread
+	// Use one buffer per thread, the buffer itself isn't thread-safe
+	class CommandBuffer {
+	private:
+		Registry* m_Registry;
+		std::vector<std::function<void(Registry&)>> m_Commands;
+
+	public:
+		CommandBuffer(Registry* registry) : m_Registry(registry) {}
+
+		// Entity handle is usable straight away for recording further commands
+		[[nodiscard]] Entity Create() { return m_Registry->ReserveEntity(); }
+
+		template <typename T, typename... Args> void EmplaceComponent(const Entity& entity, Args&&... args) {
+			m_Commands.emplace_back([entity, ...args = std::forward<Args>(args)](Registry& registry) mutable {
+				registry.EmplaceComponent<T>(entity, std::move(args)...);
+			});
+		}
+
+		template <typename T> void RemoveComponent(const Entity& entity) {
+			m_Commands.emplace_back([entity](Registry& registry) {
+				registry.RemoveComponent<T>(entity);
+			});
+		}
+
+		void FreeEntity(const Entity& entity) {
+			m_Commands.emplace_back([entity](Registry& registry) {
+				registry.FreeEntity(entity);
+			});
+		}
+
+		// Run recorded commands in order, must be on the main thread with no reservations in flight
+		void Apply() {
+			m_Registry->FlushReservedEntities();
+
+			for (std::function<void(Registry&)>& command : m_Commands) {
+				command(*m_Registry);
+			}
+
+			m_Commands.clear();
+		}
+
+		bool Empty() const { return m_Commands.empty(); }
+	};
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <span>
+#include <unordered_map>
+
+#include "Core.h"
+#include "Entity.h"
+
+namespace ECS {
+	// Base for secondary indexes, so the registry can keep them up to date without knowing T or the key
+	class ComponentIndexBase {
+	public:
+		virtual ~ComponentIndexBase() = default;
+
+		// Component of entity was added or may have changed, component points at its current value
+		virtual void Update(const Entity& entity, const std::byte* component) = 0;
+		// Entity lost the component
+		virtual void Erase(const Entity& entity) = 0;
+		// Forget every entity (before being refilled)
+		virtual void Clear() = 0;
+	};
+
+	// Key of T to entities with that key, found in O(1)
+	template <typename T, typename Key>
+	class HashIndex final : public ComponentIndexBase {
+	private:
+		std::function<Key(const T&)> m_KeyFunction;
+
+		// Entities of each key, unordered so they can be swap-popped
+		std::unordered_map<Key, std::vector<Entity>> m_Buckets;
+		// Entity to its key, and where it is in that key's bucket
+		std::unordered_map<Entity, std::pair<Key, ECS_SIZE_TYPE>> m_Entries;
+
+		void m_Insert(const Entity& entity, const Key& key) {
+			std::vector<Entity>& bucket = m_Buckets[key];
+
+			m_Entries.insert_or_assign(entity, std::make_pair(key, static_cast<ECS_SIZE_TYPE>(bucket.size())));
+			bucket.push_back(entity);
+		}
+
+	public:
+		HashIndex(std::function<Key(const T&)> key_function) : m_KeyFunction(std::move(key_function)) {}
+
+		void Update(const Entity& entity, const std::byte* component) override final {
+			Key key = m_KeyFunction(*reinterpret_cast<const T*>(component));
+			auto it = m_Entries.find(entity);
+
+			if (it != m_Entries.end()) {
+				// Key didn't change, nothing to do
+				if (it->second.first == key) return;
+
+				Erase(entity);
+			}
+
+			m_Insert(entity, key);
+		}
+
+		void Erase(const Entity& entity) override final {
+			auto it = m_Entries.find(entity);
+
+			if (it == m_Entries.end()) return;
+
+			auto bucket_it = m_Buckets.find(it->second.first);
+			std::vector<Entity>& bucket = bucket_it->second;
+			ECS_SIZE_TYPE index = it->second.second;
+
+			// Swap and pop
+			Entity last_entity = bucket.back();
+			bucket[index] = last_entity;
+			m_Entries.find(last_entity)->second.second = index;
+			bucket.pop_back();
+
+			if (bucket.empty()) { m_Buckets.erase(bucket_it); }
+
+			m_Entries.erase(entity);
+		}
+
+		void Clear() override final {
+			m_Buckets.clear();
+			m_Entries.clear();
+		}
+
+		// Every entity whose key equals key, only valid until the index next changes
+		std::span<const Entity> Find(const Key& key) const {
+			auto it = m_Buckets.find(key);
+
+			if (it == m_Buckets.end()) return {};
+
+			return it->second;
+		}
+
+		// Any entity with this key, null_entity if there isn't one
+		Entity First(const Key& key) const {
+			std::span<const Entity> entities = Find(key);
+
+			return entities.empty() ? null_entity : entities.front();
+		}
+
+		ECS_SIZE_TYPE Count(const Key& key) const { return static_cast<ECS_SIZE_TYPE>(Find(key).size()); }
+		ECS_SIZE_TYPE GetSize() const { return static_cast<ECS_SIZE_TYPE>(m_Entries.size()); }
+	};
+
+	// Key of T to entities with that key, kept sorted for O(log n) lookups and range queries
+	template <typename T, typename Key>
+	class OrderedIndex final : public ComponentIndexBase {
+	private:
+		using map_type = std::multimap<Key, Entity>;
+
+		std::function<Key(const T&)> m_KeyFunction;
+
+		map_type m_Entities;
+		// Entity to its node in the map (multimap iterators survive other insertions and erasures)
+		std::unordered_map<Entity, typename map_type::iterator> m_Entries;
+
+	public:
+		OrderedIndex(std::function<Key(const T&)> key_function) : m_KeyFunction(std::move(key_function)) {}
+
+		void Update(const Entity& entity, const std::byte* component) override final {
+			Key key = m_KeyFunction(*reinterpret_cast<const T*>(component));
+			auto it = m_Entries.find(entity);
+
+			if (it != m_Entries.end()) {
+				if (it->second->first == key) return;
+
+				m_Entities.erase(it->second);
+				it->second = m_Entities.emplace(key, entity);
+
+				return;
+			}
+
+			m_Entries.emplace(entity, m_Entities.emplace(key, entity));
+		}
+
+		void Erase(const Entity& entity) override final {
+			auto it = m_Entries.find(entity);
+
+			if (it == m_Entries.end()) return;
+
+			m_Entities.erase(it->second);
+			m_Entries.erase(it);
+		}
+
+		void Clear() override final {
+			m_Entities.clear();
+			m_Entries.clear();
+		}
+
+		// Every entity whose key equals key
+		std::vector<Entity> Find(const Key& key) const {
+			return Range(key, key);
+		}
+
+		// Every entity with low <= key <= high, in order of key
+		std::vector<Entity> Range(const Key& low, const Key& high) const {
+			std::vector<Entity> entities;
+
+			for (auto it = m_Entities.lower_bound(low); it != m_Entities.end() && !(high < it->first); ++it) {
+				entities.push_back(it->second);
+			}
+
+			return entities;
+		}
+
+		// Any entity with this key, null_entity if there isn't one
+		Entity First(const Key& key) const {
+			auto it = m_Entities.find(key);
+
+			return it == m_Entities.end() ? null_entity : it->second;
+		}
+
+		ECS_SIZE_TYPE Count(const Key& key) const { return static_cast<ECS_SIZE_TYPE>(m_Entities.count(key)); }
+		ECS_SIZE_TYPE GetSize() const { return static_cast<ECS_SIZE_TYPE>(m_Entries.size()); }
+	};
+}
@@ -17,40 +17,330 @@ namespace ECS {
 		}
 	}
 	
+	ECS_SIZE_TYPE ComponentPool::m_InsertEntity(const Entity& entity) {
+		ECS_SIZE_TYPE packed_index;
+
+		++m_LayoutEpoch;
+
+		// Re-use a tombstone if there is one
+		if (m_FreeList != null_entity) {
+			packed_index = m_FreeList;
+			// Tombstone points to the next free slot
+			m_FreeList = GetIdentifier(m_PackedArray[packed_index]);
+			--m_Tombstones;
+		}
+		// Otherwise add to end of packed list
+		else {
+			packed_index = m_PackedArray.size;
+
+			// Ensure enough space for this index
+			m_AllocatePackedSpace(packed_index);
+
+			// Increment size of both arrays
+			++m_PackedArray.size;
+			++m_ComponentArray.size;
+		}
+
+		m_Touch(packed_index);
+
+		m_SparseSet(entity, packed_index);
+		// Add entity into packed array
+		m_PackedArray[packed_index] = entity;
+
+		return packed_index;
+	}
+
+	void ComponentPool::m_DeleteAll() {
+		// No tombstones, so we can delete everything in one go
+		if (m_Tombstones == 0) {
+			m_Allocator->DeleteRange(m_ComponentArray.data, m_ComponentArray.size);
+
+			return;
+		}
+
+		for (ECS_SIZE_TYPE index = 0; index < m_PackedArray.size; index++) {
+			if (!IsTombstone(m_PackedArray[index])) {
+				m_Allocator->Delete(&m_ComponentArray[index * m_Allocator->SizeInBytes()]);
+			}
+		}
+	}
+
+	std::byte* ComponentPool::m_GetRawForEntity(const Entity& entity) {
+		ECS_SIZE_TYPE packed_index = m_SparseGet(entity);
+
+		if (packed_index == dead_entity) return nullptr;
+
+		m_Touch(packed_index);
+
+		return &m_ComponentArray[packed_index * m_Allocator->SizeInBytes()];
+	}
+
+	const std::byte* ComponentPool::m_ReadRawForEntity(const Entity& entity) const {
+		ECS_SIZE_TYPE packed_index = m_SparseGet(entity);
+
+		if (packed_index == dead_entity) return nullptr;
+
+		return &m_ComponentArray[packed_index * m_Allocator->SizeInBytes()];
+	}
+
+	void ComponentPool::m_PushRaw(const Entity& entity, std::byte* src) {
+		ECS_SIZE_TYPE packed_index = m_InsertEntity(entity);
+
+		m_Allocator->Assign(&m_ComponentArray[packed_index * m_Allocator->SizeInBytes()], src);
+	}
+
+	void ComponentPool::m_PushBytes(const Entity& entity, const std::byte* src) {
+		ECS_SIZE_TYPE packed_index = m_InsertEntity(entity);
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+
+		if (size_in_bytes != 0) { memcpy(&m_ComponentArray[packed_index * size_in_bytes], src, size_in_bytes); }
+	}
+
+	void ComponentPool::m_PushCopies(const Entity& prototype, const Entity* entities, const ECS_SIZE_TYPE& count) {
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+		ECS_SIZE_TYPE copied = 0;
+
+		// Tombstones are scattered, so fill those one at a time
+		for (; copied < count && m_FreeList != null_entity; copied++) {
+			ECS_SIZE_TYPE packed_index = m_InsertEntity(entities[copied]);
+
+			m_Allocator->Copy(&m_ComponentArray[packed_index * size_in_bytes], m_ReadRawForEntity(prototype));
+		}
+
+		if (copied == count) return;
+
+		ECS_SIZE_TYPE first = m_PackedArray.size;
+		ECS_SIZE_TYPE remaining = count - copied;
+
+		++m_LayoutEpoch;
+
+		// Grow once (before finding the prototype, growing moves it)
+		m_AllocatePackedSpace(first + remaining - 1);
+		m_TouchRange(first, first + remaining);
+
+		for (ECS_SIZE_TYPE i = 0; i < remaining; i++) {
+			m_PackedArray[first + i] = entities[copied + i];
+			m_SparseSet(entities[copied + i], first + i);
+		}
+
+		m_PackedArray.size += remaining;
+		m_ComponentArray.size += remaining;
+
+		m_Allocator->Fill(&m_ComponentArray[first * size_in_bytes], m_ReadRawForEntity(prototype), remaining);
+	}
+
+	void ComponentPool::m_PushMoved(const Entity* entities, ComponentPool* source, const ECS_SIZE_TYPE* source_indices, const ECS_SIZE_TYPE& count) {
+		if (count == 0) return;
+
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+		ECS_SIZE_TYPE first = m_PackedArray.size;
+
+		++m_LayoutEpoch;
+
+		m_AllocatePackedSpace(first + count - 1);
+		m_TouchRange(first, first + count);
+
+		for (ECS_SIZE_TYPE i = 0; i < count; i++) {
+			m_PackedArray[first + i] = entities[i];
+			m_SparseSet(entities[i], first + i);
+		}
+
+		m_PackedArray.size += count;
+		m_ComponentArray.size += count;
+
+		for (ECS_SIZE_TYPE run_first = 0; run_first < count; ) {
+			ECS_SIZE_TYPE run_last = run_first + 1;
+
+			while (run_last < count && source_indices[run_last] == source_indices[run_last - 1] + 1) { ++run_last; }
+
+			// Moved-from components are written to as well
+			source->m_TouchRange(source_indices[run_first], source_indices[run_last - 1] + 1);
+
+			m_Allocator->AssignRange(
+				&m_ComponentArray[(first + run_first) * size_in_bytes],
+				&source->m_ComponentArray[source_indices[run_first] * size_in_bytes],
+				run_last - run_first
+			);
+
+			run_first = run_last;
+		}
+	}
+
 	void ComponentPool::Swap(const Entity& a, const Entity& b) {
-		ECS_SIZE_TYPE& index_a = m_SparseArray[GetIdentifier(a)];
-		ECS_SIZE_TYPE& index_b = m_SparseArray[GetIdentifier(b)];
+		ECS_SIZE_TYPE index_a = m_SparseGet(a);
+		ECS_SIZE_TYPE index_b = m_SparseGet(b);
+
+		// Constructing a component over itself would destroy it
+		if (index_a == index_b) return;
+
+		++m_LayoutEpoch;
 
 		std::byte* location_a = &m_ComponentArray[index_a * m_Allocator->SizeInBytes()];
 		std::byte* location_b = &m_ComponentArray[index_b * m_Allocator->SizeInBytes()];
 
+		ECS_STAT(++m_Counters.swaps);
+
+		m_Touch(index_a);
+		m_Touch(index_b);
+
 		// Swap components
 		m_Allocator->Swap(location_a, location_b);
+		// Swap sparse set indices (first, a or b may refer into the packed array)
+		m_SparseSet(a, index_b);
+		m_SparseSet(b, index_a);
 		// Swap entities in packed array
 		std::swap(m_PackedArray[index_a], m_PackedArray[index_b]);
-		// Swap sparse set indices
-		std::swap(index_a, index_b);
 	}
 
 	ECS_SIZE_TYPE ComponentPool::GetID() const { return m_ID; }
 
 	void ComponentPool::FreeEntity(const Entity& entity) {
-		ECS_SIZE_TYPE& index = m_SparseArray[GetIdentifier(entity)];
+		ECS_SIZE_TYPE index = m_SparseGet(entity);
+		std::byte* location = &m_ComponentArray[index * m_Allocator->SizeInBytes()];
+
+		++m_LayoutEpoch;
+
+		m_Touch(index);
+		m_Touch(m_PackedArray.size - 1);
+
+		// Destroy the component
+		m_Allocator->Delete(location);
+
+		// Before the packed array changes, entity may refer into it
+		m_SparseSet(entity, dead_entity);
+
+		// Leave a tombstone that links to the rest of the free list, nothing else moves
+		if (m_InPlaceDelete) {
+			m_PackedArray[index] = tomb_entity | m_FreeList;
+			m_FreeList = index;
+			++m_Tombstones;
+
+			return;
+		}
+
+		// Move last component into the freed slot
+		ECS_SIZE_TYPE last_index = m_PackedArray.size - 1;
+
+		if (index != last_index) {
+			std::byte* last_location = &m_ComponentArray[last_index * m_Allocator->SizeInBytes()];
+			Entity last_entity = m_PackedArray[last_index];
+
+			m_Allocator->Assign(location, last_location);
+			m_Allocator->Delete(last_location);
+
+			m_PackedArray[index] = last_entity;
+			m_SparseSet(last_entity, index);
+		}
+
+		m_PackedArray[last_index] = dead_entity;
 
-		Swap(index, m_PackedArray.size - 1);
-		index = dead_entity;
 		--m_PackedArray.size;
 		--m_ComponentArray.size;
 	}
 
+	void ComponentPool::m_Commit(ECS_SIZE_TYPE new_capacity)
+	{
+		// Can't grow past the reservation
+		new_capacity = std::min<ECS_SIZE_TYPE>(new_capacity, ECS_ENTITY_MAX + 1);
+
+		std::size_t packed_bytes = VirtualMemory::RoundToPage(new_capacity * sizeof(Entity));
+		std::size_t component_bytes = VirtualMemory::RoundToPage(new_capacity * m_Allocator->SizeInBytes());
+
+		if (packed_bytes > m_CommittedPackedBytes) {
+			std::byte* start = reinterpret_cast<std::byte*>(m_PackedArray.data) + m_CommittedPackedBytes;
+
+			if (!VirtualMemory::Commit(start, packed_bytes - m_CommittedPackedBytes)) {
+				LogFatal("Failed to commit {} bytes for pool of component {}", packed_bytes - m_CommittedPackedBytes, m_ID);
+			}
+
+			m_CommittedPackedBytes = packed_bytes;
+		}
+
+		if (component_bytes > m_CommittedComponentBytes) {
+			if (!VirtualMemory::Commit(m_ComponentArray.data + m_CommittedComponentBytes, component_bytes - m_CommittedComponentBytes)) {
+				LogFatal("Failed to commit {} bytes for pool of component {}", component_bytes - m_CommittedComponentBytes, m_ID);
+			}
+
+			m_CommittedComponentBytes = component_bytes;
+		}
+
+		// Rest should be nulls
+		std::fill_n(m_PackedArray.data + m_PackedArray.capacity, new_capacity - m_PackedArray.capacity, dead_entity);
+
+		m_PackedArray.capacity = new_capacity;
+		m_ComponentArray.capacity = new_capacity;
+	}
+
+	void ComponentPool::ShrinkToFit()
+	{
+		if (!m_VirtualMemory) return;
+
+		std::size_t packed_bytes = VirtualMemory::RoundToPage(m_PackedArray.size * sizeof(Entity));
+		std::size_t component_bytes = VirtualMemory::RoundToPage(m_ComponentArray.size * m_Allocator->SizeInBytes());
+
+		if (packed_bytes < m_CommittedPackedBytes) {
+			VirtualMemory::Decommit(reinterpret_cast<std::byte*>(m_PackedArray.data) + packed_bytes, m_CommittedPackedBytes - packed_bytes);
+
+			m_CommittedPackedBytes = packed_bytes;
+		}
+
+		if (component_bytes < m_CommittedComponentBytes) {
+			VirtualMemory::Decommit(m_ComponentArray.data + component_bytes, m_CommittedComponentBytes - component_bytes);
+
+			m_CommittedComponentBytes = component_bytes;
+		}
+
+		// Whatever both arrays still have room for
+		m_PackedArray.capacity = static_cast<ECS_SIZE_TYPE>(std::min(m_CommittedPackedBytes / sizeof(Entity), m_CommittedComponentBytes / m_Allocator->SizeInBytes()));
+		m_ComponentArray.capacity = m_PackedArray.capacity;
+	}
+
+	Entity* ComponentPool::m_AllocateEntities(const ECS_SIZE_TYPE& count)
+	{
+		return static_cast<Entity*>(::operator new(count * sizeof(Entity), std::align_val_t(ECS_POOL_ALIGN)));
+	}
+
+	std::byte* ComponentPool::m_AllocateComponents(const ECS_SIZE_TYPE& count)
+	{
+		return static_cast<std::byte*>(::operator new(count * m_Allocator->SizeInBytes(), std::align_val_t(m_Alignment)));
+	}
+
+	void ComponentPool::m_FreeEntities(Entity* data)
+	{
+		::operator delete(data, std::align_val_t(ECS_POOL_ALIGN));
+	}
+
+	void ComponentPool::m_FreeComponents(std::byte* data)
+	{
+		::operator delete(data, std::align_val_t(m_Alignment));
+	}
+
 	void ComponentPool::Resize(ECS_SIZE_TYPE new_capacity)
 	{
 		if (new_capacity <= m_PackedArray.capacity) return;
 
+		++m_LayoutEpoch;
+
+		ECS_TRACE_ZONE("ComponentPool::Resize");
+
+		ECS_STAT(++m_Counters.resizes);
+
+		// Sized up front so marking pages written never allocates
+		if (m_DoubleBuffered) {
+			m_PageWrites.resize((new_capacity - 1) / ECS_PACKED_PAGE + 1, 0);
+		}
+
+		// Nothing has to move
+		if (m_VirtualMemory) {
+			m_Commit(new_capacity);
+
+			return;
+		}
+
 		// Resize packed array
 		{
 			// Create new array
-			Entity* new_data = new Entity[new_capacity];
+			Entity* new_data = m_AllocateEntities(new_capacity);
 			// Move data
 			std::memcpy(new_data, m_PackedArray.data, m_PackedArray.capacity * sizeof(Entity));
 			// Rest should be nulls
@@ -59,7 +349,7 @@ namespace ECS {
 			// Update capacity
 			m_PackedArray.capacity = new_capacity;
 			// Delete old data
-			delete[] m_PackedArray.data;
+			m_FreeEntities(m_PackedArray.data);
 			// Replace old data with ptr to new data
 			m_PackedArray.data = new_data;
 		}
@@ -67,37 +357,549 @@ namespace ECS {
 		// Resize component array
 		{
 			// Create new array
-			std::byte* new_data = new std::byte[new_capacity * m_Allocator->SizeInBytes()];
+			std::byte* new_data = m_AllocateComponents(new_capacity);
 			// Copy data from old array to new one
-			m_Allocator->AssignRange(new_data, m_ComponentArray.data, m_ComponentArray.size);
+			if (m_Tombstones == 0) {
+				m_Allocator->AssignRange(new_data, m_ComponentArray.data, m_ComponentArray.size);
+			}
+			// Tombstones have already been destroyed, so only move the live components
+			else {
+				std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+
+				for (ECS_SIZE_TYPE index = 0; index < m_PackedArray.size; index++) {
+					if (!IsTombstone(m_PackedArray[index])) {
+						m_Allocator->Assign(new_data + index * size_in_bytes, &m_ComponentArray[index * size_in_bytes]);
+					}
+				}
+			}
+
+			// Deconstruct moved-from components
+			m_DeleteAll();
 
 			// Update capacity
 			m_ComponentArray.capacity = new_capacity;
 			// Delete old data
-			delete[] m_ComponentArray.data;
+			m_FreeComponents(m_ComponentArray.data);
 			// Replace old data with ptr to new data
 			m_ComponentArray.data = new_data;
 		}
 	}
 
+	void ComponentPool::Compact()
+	{
+		if (m_Tombstones == 0) return;
+
+		++m_LayoutEpoch;
+
+		m_TouchRange(0, m_PackedArray.size);
+
+		ECS_SIZE_TYPE left = 0;
+		ECS_SIZE_TYPE right = m_PackedArray.size;
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+
+		// Fill tombstones at the front with live components from the back
+		while (true) {
+			while (left < right && !IsTombstone(m_PackedArray[left])) { ++left; }
+			while (left < right && IsTombstone(m_PackedArray[right - 1])) { --right; }
+
+			if (left >= right) break;
+
+			// Move component
+			std::byte* location = &m_ComponentArray[left * size_in_bytes];
+			std::byte* last_location = &m_ComponentArray[(right - 1) * size_in_bytes];
+
+			m_Allocator->Assign(location, last_location);
+			m_Allocator->Delete(last_location);
+
+			// Move entity
+			Entity moved_entity = m_PackedArray[right - 1];
+			m_PackedArray[left] = moved_entity;
+			m_SparseSet(moved_entity, left);
+
+			--right;
+			++left;
+		}
+
+		// Everything past the live components is now unused
+		std::fill_n(m_PackedArray.data + left, m_PackedArray.size - left, dead_entity);
+
+		m_PackedArray.size = left;
+		m_ComponentArray.size = left;
+		m_FreeList = null_entity;
+		m_Tombstones = 0;
+	}
+
+	void ComponentPool::m_Reorder(const Entity* front, ECS_SIZE_TYPE count)
+	{
+		if (count == 0) return;
+
+		++m_LayoutEpoch;
+
+		ECS_TRACE_ZONE("ComponentPool::Reorder");
+
+		// Tombstones would have to be carried through the new order, easier to drop them first
+		Compact();
+
+		m_TouchRange(0, m_PackedArray.size);
+
+		ECS_SIZE_TYPE size = m_PackedArray.size;
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+
+		// Which of the old indices have been moved already
+		std::vector<bool> placed(size, false);
+
+		Entity* new_entities = m_AllocateEntities(m_PackedArray.capacity);
+		std::byte* new_data = m_AllocateComponents(m_ComponentArray.capacity);
+		ECS_SIZE_TYPE new_index = 0;
+
+		auto place = [&](const ECS_SIZE_TYPE& old_index) {
+			m_Allocator->Assign(new_data + new_index * size_in_bytes, &m_ComponentArray[old_index * size_in_bytes]);
+			new_entities[new_index] = m_PackedArray[old_index];
+			placed[old_index] = true;
+
+			++new_index;
+		};
+
+		// Requested entities first
+		for (ECS_SIZE_TYPE i = 0; i < count; i++) {
+			place(m_SparseGet(front[i]));
+		}
+
+		// Then the rest, in the order they were already in
+		for (ECS_SIZE_TYPE old_index = 0; old_index < size; old_index++) {
+			if (!placed[old_index]) { place(old_index); }
+		}
+
+		std::fill_n(new_entities + size, m_PackedArray.capacity - size, dead_entity);
+
+		// Deconstruct moved-from components
+		m_Allocator->DeleteRange(m_ComponentArray.data, size);
+
+		// Reservations can't be swapped for heap memory, so copy the new order back into them
+		if (m_VirtualMemory) {
+			m_Allocator->AssignRange(m_ComponentArray.data, new_data, size);
+			m_Allocator->DeleteRange(new_data, size);
+			std::memcpy(m_PackedArray.data, new_entities, size * sizeof(Entity));
+
+			m_FreeComponents(new_data);
+			m_FreeEntities(new_entities);
+		}
+		else {
+			m_FreeComponents(m_ComponentArray.data);
+			m_ComponentArray.data = new_data;
+			m_FreeEntities(m_PackedArray.data);
+			m_PackedArray.data = new_entities;
+		}
+
+		// Point sparse array at the new slots
+		for (ECS_SIZE_TYPE index = 0; index < size; index++) {
+			m_SparseSet(m_PackedArray[index], index);
+		}
+	}
+
+	void ComponentPool::m_Rotate(const ECS_SIZE_TYPE& first, const ECS_SIZE_TYPE& middle, const ECS_SIZE_TYPE& last)
+	{
+		if (first == middle || middle == last) return;
+
+		++m_LayoutEpoch;
+
+		m_TouchRange(first, last);
+
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+		std::byte* data = m_ComponentArray.data;
+
+		if (m_Allocator->TriviallyCopyable()) {
+			// Park the shorter side, slide the longer one over, then drop the parked one in behind it
+			std::size_t left = (middle - first) * size_in_bytes;
+			std::size_t right = (last - middle) * size_in_bytes;
+
+			if (left <= right) {
+				std::vector<std::byte> parked(data + first * size_in_bytes, data + middle * size_in_bytes);
+				std::memmove(data + first * size_in_bytes, data + middle * size_in_bytes, right);
+				std::memcpy(data + first * size_in_bytes + right, parked.data(), left);
+			}
+			else {
+				std::vector<std::byte> parked(data + middle * size_in_bytes, data + last * size_in_bytes);
+				std::memmove(data + first * size_in_bytes + right, data + first * size_in_bytes, left);
+				std::memcpy(data + first * size_in_bytes, parked.data(), right);
+			}
+		}
+		else {
+			// Three reversals, so components only ever move through Swap
+			auto reverse = [&](ECS_SIZE_TYPE a, ECS_SIZE_TYPE b) {
+				for (; a + 1 < b; a++, b--) {
+					m_Allocator->Swap(data + a * size_in_bytes, data + (b - 1) * size_in_bytes);
+				}
+			};
+
+			reverse(first, middle);
+			reverse(middle, last);
+			reverse(first, last);
+		}
+
+		std::rotate(m_PackedArray.data + first, m_PackedArray.data + middle, m_PackedArray.data + last);
+
+		// Everything in the range moved
+		for (ECS_SIZE_TYPE index = first; index < last; index++) {
+			if (!IsTombstone(m_PackedArray[index])) { m_SparseSet(m_PackedArray[index], index); }
+		}
+	}
+
+	void ComponentPool::m_TouchRange(const ECS_SIZE_TYPE& first, const ECS_SIZE_TYPE& last)
+	{
+		if ((m_Fork == nullptr && !m_DoubleBuffered) || first >= last) return;
+
+		for (ECS_SIZE_TYPE page = first / ECS_PACKED_PAGE; page <= (last - 1) / ECS_PACKED_PAGE; page++) {
+			m_Touch(page * ECS_PACKED_PAGE);
+		}
+	}
+
+	void ComponentPool::m_SavePage(const ECS_SIZE_TYPE& page)
+	{
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+		ECS_SIZE_TYPE first = page * ECS_PACKED_PAGE;
+
+		PoolFork::Page& saved = m_Fork->pages[page];
+		saved.entities = std::unique_ptr<Entity[]>(new Entity[ECS_PACKED_PAGE]);
+		saved.components = PoolFork::Components(
+			static_cast<std::byte*>(::operator new(ECS_PACKED_PAGE * size_in_bytes, std::align_val_t(m_Alignment))),
+			AlignedDelete{ m_Alignment }
+		);
+
+		for (ECS_SIZE_TYPE i = 0; i < ECS_PACKED_PAGE; i++) {
+			ECS_SIZE_TYPE index = first + i;
+			// Anything past the end counts as empty
+			Entity entity = index < m_PackedArray.size ? m_PackedArray[index] : dead_entity;
+
+			saved.entities[i] = entity;
+
+			if (!IsTombstone(entity)) {
+				m_Allocator->Copy(&saved.components[i * size_in_bytes], &m_ComponentArray[index * size_in_bytes]);
+			}
+		}
+
+		m_PageVersions[page] = m_ForkEpoch;
+	}
+
+	void ComponentPool::m_RestoreFork(const std::vector<PoolFork*>& forks, const std::uint32_t& epoch)
+	{
+		PoolFork* target = forks.front();
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+
+		++m_LayoutEpoch;
+
+		// Every page written to since target, as it was in the oldest fork that saved it
+		std::unordered_map<ECS_SIZE_TYPE, PoolFork::Page*> pages;
+
+		for (PoolFork* fork : forks) {
+			for (auto& [page, saved] : fork->pages) {
+				pages.try_emplace(page, &saved);
+			}
+		}
+
+		Resize(target->size);
+
+		// Take out whatever is in those pages now
+		for (auto& [page, saved] : pages) {
+			ECS_SIZE_TYPE last = std::min((page + 1) * ECS_PACKED_PAGE, m_PackedArray.size);
+
+			for (ECS_SIZE_TYPE index = page * ECS_PACKED_PAGE; index < last; index++) {
+				Entity entity = m_PackedArray[index];
+
+				if (!IsTombstone(entity)) {
+					m_SparseSet(entity, dead_entity);
+					m_Allocator->Delete(&m_ComponentArray[index * size_in_bytes]);
+				}
+			}
+		}
+
+		// Then put back what was there (copying, so the fork can be restored again)
+		for (auto& [page, saved] : pages) {
+			ECS_SIZE_TYPE first = page * ECS_PACKED_PAGE;
+			ECS_SIZE_TYPE last = std::min(first + ECS_PACKED_PAGE, m_PackedArray.capacity);
+
+			for (ECS_SIZE_TYPE index = first; index < last; index++) {
+				Entity entity = saved->entities[index - first];
+
+				m_PackedArray[index] = entity;
+
+				if (!IsTombstone(entity)) {
+					m_Allocator->Copy(&m_ComponentArray[index * size_in_bytes], &saved->components[(index - first) * size_in_bytes]);
+					m_SparseSet(entity, index);
+				}
+			}
+		}
+
+		m_PackedArray.size = target->size;
+		m_ComponentArray.size = target->size;
+		m_FreeList = target->free_list;
+		m_Tombstones = target->tombstones;
+
+		// Written to without being touched
+		std::fill(m_PageWrites.begin(), m_PageWrites.end(), m_FlipGeneration);
+
+		// Only the pages target has saved are up to date in it now
+		m_Fork = target;
+		m_ForkEpoch = epoch;
+
+		std::fill(m_PageVersions.begin(), m_PageVersions.end(), 0);
+
+		for (auto& [page, saved] : target->pages) {
+			if (page >= m_PageVersions.size()) { m_PageVersions.resize(page + 1, 0); }
+
+			m_PageVersions[page] = epoch;
+		}
+	}
+
+	void ComponentPool::m_Clear()
+	{
+		++m_LayoutEpoch;
+
+		m_TouchRange(0, m_PackedArray.size);
+
+		for (ECS_SIZE_TYPE index = 0; index < m_PackedArray.size; index++) {
+			if (!IsTombstone(m_PackedArray[index])) {
+				m_SparseSet(m_PackedArray[index], dead_entity);
+			}
+		}
+
+		m_DeleteAll();
+
+		std::fill_n(m_PackedArray.data, m_PackedArray.size, dead_entity);
+
+		m_PackedArray.size = 0;
+		m_ComponentArray.size = 0;
+		m_FreeList = null_entity;
+		m_Tombstones = 0;
+	}
+
+	void ComponentPool::m_DeleteFront(FrontBuffer& buffer)
+	{
+		if (buffer.entities == nullptr) return;
+
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+
+		for (ECS_SIZE_TYPE index = 0; index < buffer.size; index++) {
+			if (!IsTombstone(buffer.entities[index])) {
+				m_Allocator->Delete(&buffer.components[index * size_in_bytes]);
+			}
+		}
+
+		m_FreeEntities(buffer.entities);
+		m_FreeComponents(buffer.components);
+
+		buffer.entities = nullptr;
+		buffer.components = nullptr;
+		buffer.size = 0;
+		buffer.capacity = 0;
+	}
+
+	void ComponentPool::m_GrowFront(FrontBuffer& buffer, const ECS_SIZE_TYPE& capacity)
+	{
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+
+		Entity* entities = m_AllocateEntities(capacity);
+		std::byte* components = m_AllocateComponents(capacity);
+
+		std::fill_n(entities, capacity, dead_entity);
+
+		// What it holds is still right for every page that hasn't been written since, so keep it
+		for (ECS_SIZE_TYPE index = 0; index < buffer.size; index++) {
+			if (IsTombstone(buffer.entities[index])) continue;
+
+			m_Allocator->Assign(&components[index * size_in_bytes], &buffer.components[index * size_in_bytes]);
+			m_Allocator->Delete(&buffer.components[index * size_in_bytes]);
+			entities[index] = buffer.entities[index];
+		}
+
+		if (buffer.entities != nullptr) {
+			m_FreeEntities(buffer.entities);
+			m_FreeComponents(buffer.components);
+		}
+
+		buffer.entities = entities;
+		buffer.components = components;
+		buffer.capacity = capacity;
+	}
+
+	const ComponentPool::FrontBuffer* ComponentPool::m_AcquireFront() const
+	{
+		FrontBuffer* buffer = m_Front.load(std::memory_order_seq_cst);
+
+		while (buffer != nullptr) {
+			buffer->readers.fetch_add(1, std::memory_order_seq_cst);
+
+			// Flip only writes buffers that aren't published and have no readers, both checked in the opposite order to this
+			// So if it's still the published one, no Flip can have started writing to it
+			FrontBuffer* published = m_Front.load(std::memory_order_seq_cst);
+
+			if (published == buffer) return buffer;
+
+			buffer->readers.fetch_sub(1, std::memory_order_release);
+			buffer = published;
+		}
+
+		return nullptr;
+	}
+
+	void ComponentPool::Flip()
+	{
+		if (!m_DoubleBuffered) return;
+
+		ECS_TRACE_ZONE("ComponentPool::Flip");
+
+		// Only Flip publishes, so this is what readers can be on besides older buffers they pinned
+		FrontBuffer* front = m_Front.load(std::memory_order_relaxed);
+		FrontBuffer* back = nullptr;
+
+		// Least recently published buffer nobody is reading, it has the fewest pages to catch up on
+		for (std::size_t slot = 0; slot < m_FrontBufferCount; slot++) {
+			FrontBuffer& buffer = m_FrontBuffers[slot];
+
+			if (&buffer == front || buffer.readers.load(std::memory_order_seq_cst) != 0) continue;
+
+			if (back == nullptr || buffer.generation < back->generation) { back = &buffer; }
+		}
+
+		// Slow readers hold both older buffers, they'll see these writes at a later Flip
+		if (back == nullptr) return;
+
+		std::size_t size_in_bytes = m_Allocator->SizeInBytes();
+
+		if (back->capacity < m_PackedArray.size) { m_GrowFront(*back, m_PackedArray.capacity); }
+
+		// Slots past our size may still hold components in the buffer
+		ECS_SIZE_TYPE last = std::max(back->size, m_PackedArray.size);
+		bool trivially_copyable = m_Allocator->TriviallyCopyable();
+
+		for (ECS_SIZE_TYPE page = 0; page * ECS_PACKED_PAGE < last; page++) {
+			// Pages past m_PageWrites can only be there if the pool shrank, so they changed
+			if (page < m_PageWrites.size() && m_PageWrites[page] <= back->generation) continue;
+
+			ECS_SIZE_TYPE page_first = page * ECS_PACKED_PAGE;
+			ECS_SIZE_TYPE page_end = std::min(page_first + ECS_PACKED_PAGE, last);
+			ECS_SIZE_TYPE live_end = std::clamp(m_PackedArray.size, page_first, page_end);
+
+			// Plain bytes, the whole page goes in two copies (tombstones included, readers skip them)
+			if (trivially_copyable) {
+				std::memcpy(&back->entities[page_first], &m_PackedArray[page_first], (live_end - page_first) * sizeof(Entity));
+				std::fill(back->entities + live_end, back->entities + page_end, dead_entity);
+
+				if (size_in_bytes != 0) {
+					std::memcpy(&back->components[page_first * size_in_bytes], &m_ComponentArray[page_first * size_in_bytes], (live_end - page_first) * size_in_bytes);
+				}
+
+				continue;
+			}
+
+			for (ECS_SIZE_TYPE index = page_first; index < page_end; index++) {
+				Entity& back_entity = back->entities[index];
+
+				if (!IsTombstone(back_entity)) {
+					m_Allocator->Delete(&back->components[index * size_in_bytes]);
+					back_entity = dead_entity;
+				}
+
+				if (index < live_end && !IsTombstone(m_PackedArray[index])) {
+					m_Allocator->Copy(&back->components[index * size_in_bytes], &m_ComponentArray[index * size_in_bytes]);
+					back_entity = m_PackedArray[index];
+				}
+			}
+		}
+
+		back->size = m_PackedArray.size;
+		back->generation = m_FlipGeneration;
+
+		// Swap it in, readers from now on get this one, ones already reading keep theirs
+		m_Front.store(back, std::memory_order_seq_cst);
+
+		++m_FlipGeneration;
+	}
+
+	PoolFork::~PoolFork() {
+		std::size_t size_in_bytes = allocator->SizeInBytes();
+
+		// Destroy the copies we made
+		for (auto& [page, saved] : pages) {
+			// Handed over to an older fork
+			if (saved.entities == nullptr) continue;
+
+			for (ECS_SIZE_TYPE i = 0; i < ECS_PACKED_PAGE; i++) {
+				if (!IsTombstone(saved.entities[i])) {
+					allocator->Delete(&saved.components[i * size_in_bytes]);
+				}
+			}
+		}
+	}
+
 	bool ComponentPool::Contains(const Entity& entity)
 	{
-		return m_SparseArray[GetIdentifier(entity)] != dead_entity;
+		return m_SparseGet(entity) != dead_entity;
 	}
 
 	ECS_SIZE_TYPE ComponentPool::GetSize() const {
 		return m_PackedArray.size;
 	}
+
+	ECS_SIZE_TYPE ComponentPool::GetTombstoneCount() const {
+		return m_Tombstones;
+	}
+
+	PoolStats ComponentPool::Stats() const {
+		PoolStats stats;
+		std::size_t element_size = sizeof(Entity) + m_Allocator->SizeInBytes();
+
+		stats.id = m_ID;
+		stats.size = m_PackedArray.size;
+		stats.capacity = m_PackedArray.capacity;
+		stats.tombstones = m_Tombstones;
+		stats.sparse_pages = m_SparseArray.GetResidentPageCount();
+		stats.bytes_used = stats.size * element_size;
+		stats.bytes_reserved = stats.capacity * element_size + stats.sparse_pages * m_SparseArray.GetPageSizeInBytes() + m_SparseHash.GetSizeInBytes();
+
+		// Only committed memory counts, the rest of the reservation is just address space
+		if (m_VirtualMemory) {
+			stats.bytes_reserved = m_CommittedPackedBytes + m_CommittedComponentBytes + stats.sparse_pages * m_SparseArray.GetPageSizeInBytes() + m_SparseHash.GetSizeInBytes();
+		}
+
+		for (std::size_t slot = 0; m_DoubleBuffered && slot < m_FrontBufferCount; slot++) {
+			stats.bytes_reserved += m_FrontBuffers[slot].capacity * element_size;
+		}
+		stats.resizes = m_Counters.resizes;
+		stats.swaps = m_Counters.swaps;
+
+		return stats;
+	}
 	
 	ComponentPool::~ComponentPool() {
-		if (m_PackedArray.data != nullptr) {
-			delete[] m_PackedArray.data;
+		if (m_Allocator != nullptr && m_FrontBuffers != nullptr) {
+			for (std::size_t slot = 0; slot < m_FrontBufferCount; slot++) {
+				m_DeleteFront(m_FrontBuffers[slot]);
+			}
+		}
+
+		if (m_VirtualMemory) {
+			if (m_ComponentArray.data != nullptr) {
+				m_DeleteAll();
+
+				VirtualMemory::Release(m_ComponentArray.data, m_ReservedComponentBytes());
+			}
+
+			if (m_PackedArray.data != nullptr) {
+				VirtualMemory::Release(m_PackedArray.data, m_ReservedPackedBytes());
+			}
 		}
+		else {
+			// Components first, m_DeleteAll reads the packed array to skip tombstones
+			if (m_ComponentArray.data != nullptr) {
+				m_DeleteAll();
 
-		if (m_ComponentArray.size > 0) {
-			m_Allocator->DeleteRange(&m_ComponentArray[0], m_ComponentArray.capacity);
+				m_FreeComponents(m_ComponentArray.data);
+			}
 
-			delete[] m_ComponentArray.data;
+			if (m_PackedArray.data != nullptr) {
+				m_FreeEntities(m_PackedArray.data);
+			}
 		}
 
 		if (m_Allocator != nullptr) {
@@ -107,25 +909,79 @@ namespace ECS {
 	
 	ComponentPool::ComponentPool(ComponentPool&& other) noexcept
 		: m_SparseArray(std::move(other.m_SparseArray)),
+		m_SparseHash(std::move(other.m_SparseHash)),
+		m_Hashed(other.m_Hashed),
 		m_PackedArray(std::move(other.m_PackedArray)),
 		m_ComponentArray(std::move(other.m_ComponentArray)),
 		m_Allocator(std::move(other.m_Allocator)),
+		m_FreeList(other.m_FreeList),
+		m_Tombstones(other.m_Tombstones),
+		m_InPlaceDelete(other.m_InPlaceDelete),
+		m_VirtualMemory(other.m_VirtualMemory),
+		m_CommittedPackedBytes(other.m_CommittedPackedBytes),
+		m_CommittedComponentBytes(other.m_CommittedComponentBytes),
+		m_Alignment(other.m_Alignment),
+		m_DoubleBuffered(other.m_DoubleBuffered),
+		m_FrontBuffers(std::move(other.m_FrontBuffers)),
+		m_Front(other.m_Front.load(std::memory_order_relaxed)),
+		m_FlipGeneration(other.m_FlipGeneration),
+		m_PageWrites(std::move(other.m_PageWrites)),
+		m_LayoutEpoch(other.m_LayoutEpoch),
+		m_Counters(other.m_Counters),
 		m_ID(std::move(other.m_ID))
-	{}
+	{
+		other.m_Allocator = nullptr;
+		other.m_Front.store(nullptr, std::memory_order_relaxed);
+	}
 
 	ComponentPool& ComponentPool::operator=(ComponentPool&& other) noexcept {
 		m_SparseArray = std::move(other.m_SparseArray);
+		m_SparseHash = std::move(other.m_SparseHash);
+		m_Hashed = other.m_Hashed;
 		m_PackedArray = std::move(other.m_PackedArray);
 		m_ComponentArray = std::move(other.m_ComponentArray);
+		m_FreeList = other.m_FreeList;
+		m_Tombstones = other.m_Tombstones;
+		m_InPlaceDelete = other.m_InPlaceDelete;
+		m_VirtualMemory = other.m_VirtualMemory;
+		m_CommittedPackedBytes = other.m_CommittedPackedBytes;
+		m_CommittedComponentBytes = other.m_CommittedComponentBytes;
+		m_Alignment = other.m_Alignment;
+		m_DoubleBuffered = other.m_DoubleBuffered;
+		m_FrontBuffers = std::move(other.m_FrontBuffers);
+		m_Front.store(other.m_Front.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		m_FlipGeneration = other.m_FlipGeneration;
+		m_PageWrites = std::move(other.m_PageWrites);
+		m_LayoutEpoch = other.m_LayoutEpoch;
+		m_Counters = other.m_Counters;
 		m_ID = std::move(other.m_ID);
 
+		other.m_Front.store(nullptr, std::memory_order_relaxed);
+
 		return *this;
 	}
 	
 	ComponentPool::ComponentPool(ComponentAllocatorBase* allocator)
-		: m_Allocator(allocator), m_ID(allocator->GetComponentID())
+		: m_Hashed(allocator->Storage() == StoragePolicy::Hashed), m_Allocator(allocator), m_InPlaceDelete(allocator->InPlaceDelete()), m_VirtualMemory(allocator->UsesVirtualMemory()), m_Alignment(std::max<std::size_t>(ECS_POOL_ALIGN, allocator->AlignOf())), m_DoubleBuffered(allocator->DoubleBuffered()), m_ID(allocator->GetComponentID())
 	{
 		// TODO: pretty bad, should be in constructor
 		m_SparseArray.SetDefault(dead_entity);
+
+		if (m_DoubleBuffered) { m_FrontBuffers = std::make_unique<FrontBuffer[]>(m_FrontBufferCount); }
+
+		// Reserve for the largest the pool can ever be, memory is only committed by Resize
+		if (m_VirtualMemory) {
+			m_PackedArray.data = static_cast<Entity*>(VirtualMemory::Reserve(m_ReservedPackedBytes()));
+			m_ComponentArray.data = static_cast<std::byte*>(VirtualMemory::Reserve(m_ReservedComponentBytes()));
+
+			if (m_PackedArray.data == nullptr || m_ComponentArray.data == nullptr) {
+				LogFatal("Failed to reserve address space for pool of component {}", m_ID);
+			}
+
+#if ECS_VIRTUAL_MEMORY_HUGE_PAGES
+			VirtualMemory::AdviseHugePages(m_PackedArray.data, m_ReservedPackedBytes());
+			VirtualMemory::AdviseHugePages(m_ComponentArray.data, m_ReservedComponentBytes());
+#endif
+		}
 	}
 }
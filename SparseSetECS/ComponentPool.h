@@ -4,12 +4,20 @@
 #include "PagedArray.h"
 #include "Entity.h"
 #include "Family.h"
+#include "ComponentTraits.h"
 #include "GroupData.h"
 #include "WrappedArray.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "VirtualMemory.h"
+#include "Fork.h"
+#include "SparseHashMap.h"
 
 namespace ECS {
 	template <typename T>
 	class SingleView;
+	template <typename T>
+	class FrontView;
 	template <IsValidOwnershipTag... WrappedTypes>
 	class Group;
 	struct GroupData;
@@ -20,13 +28,26 @@ namespace ECS {
 		virtual ~ComponentAllocatorBase() = default;
 
 		virtual void Assign(std::byte* dest, std::byte* src) const = 0;
+		virtual void Copy(std::byte* dest, const std::byte* src) const = 0;
 		virtual void Delete(std::byte* data) const = 0;
 		virtual void AssignRange(std::byte* dest, std::byte* src, ECS_SIZE_TYPE count) const = 0;
 		virtual void DeleteRange(std::byte* data, ECS_SIZE_TYPE count) const = 0;
+		// Copy construct count components in a row at dest, all from src
+		virtual void Fill(std::byte* dest, const std::byte* src, ECS_SIZE_TYPE count) const = 0;
 		virtual void Swap(std::byte* a, std::byte* b) const = 0;
 
 		virtual std::size_t SizeInBytes() const = 0;
+		virtual std::size_t AlignOf() const = 0;
 		virtual ECS_COMP_ID_TYPE GetComponentID() const = 0;
+		virtual bool InPlaceDelete() const = 0;
+		virtual bool UsesVirtualMemory() const = 0;
+		virtual bool DoubleBuffered() const = 0;
+		virtual StoragePolicy Storage() const = 0;
+		// Can be saved and brought back as plain bytes (see Registry::Evict)
+		virtual bool TriviallyCopyable() const = 0;
+
+		// New allocator for the same type, for creating an equivalent pool in another registry
+		virtual ComponentAllocatorBase* Clone() const = 0;
 	};
 
 	// For moving, deleting, and allocating data of some type T (somewhat) safely
@@ -35,12 +56,19 @@ namespace ECS {
 	private:
 		static const ECS_COMP_ID_TYPE m_ID;
 
+		// Tags are never stored, so nothing is ever moved or destroyed
+		static constexpr bool m_Stored = ComponentTraits<T>::storage != StoragePolicy::Tag;
+
+		static_assert(m_Stored || std::is_empty_v<T>, "Only empty types can use StoragePolicy::Tag");
+		static_assert(m_Stored || !ComponentTraits<T>::virtual_memory, "Tags have nothing to reserve memory for");
+
 	public:
 		static constexpr ECS_COMP_ID_TYPE GetID() { return m_ID; }
 
 		void Assign(std::byte* dest, std::byte* src) const override final {
+			if constexpr (!m_Stored) return;
 			// Attempt a simple memcpy if possible
-			if constexpr (std::is_trivially_constructible_v<T>) {
+			else if constexpr (std::is_trivially_constructible_v<T>) {
 				memcpy(dest, src, sizeof(T));
 			}
 			else if constexpr (std::is_move_constructible_v<T>) {
@@ -54,16 +82,32 @@ namespace ECS {
 			}
 		}
 
+		void Copy(std::byte* dest, const std::byte* src) const override final {
+			if constexpr (!m_Stored) return;
+			else if constexpr (std::is_trivially_copyable_v<T>) {
+				memcpy(dest, src, sizeof(T));
+			}
+			else if constexpr (std::is_copy_constructible_v<T>) {
+				new (dest) T(*reinterpret_cast<const T*>(src));
+			}
+			else {
+				LogFatal("Attempted to copy object of {}, but no available constructor", typeid(T).name());
+			}
+		}
+
 		void Delete(std::byte* data) const override final {
-			T* ptr = std::launder(reinterpret_cast<T*>(data));
+			if constexpr (m_Stored) {
+				T* ptr = std::launder(reinterpret_cast<T*>(data));
 
-			// Call deconstructor
-			ptr->~T();
+				// Call deconstructor
+				ptr->~T();
+			}
 		}
 		
 		void AssignRange(std::byte* dest, std::byte* src, ECS_SIZE_TYPE count) const override final {
+			if constexpr (!m_Stored) return;
 			// Attempt simple memcpy of entire range if possible (very fast)
-			if constexpr (std::is_trivially_constructible_v<T>) {
+			else if constexpr (std::is_trivially_constructible_v<T>) {
 				memcpy(dest, src, count * sizeof(T));
 			}
 			// Otherwise we must do member-wise move/copy (very slow)
@@ -81,7 +125,7 @@ namespace ECS {
 
 		void DeleteRange(std::byte* data, ECS_SIZE_TYPE count) const override final {
 			// If not trivially destructible, we must cll delete for each member
-			if constexpr (!std::is_trivially_destructible_v<T>) {
+			if constexpr (m_Stored && !std::is_trivially_destructible_v<T>) {
 				// Iterate each member
 				for (ECS_SIZE_TYPE i = 0; i < count; i++) {
 					// Delete member
@@ -91,26 +135,76 @@ namespace ECS {
 			// Otherwise do nothing
 		}
 
+		void Fill(std::byte* dest, const std::byte* src, ECS_SIZE_TYPE count) const override final {
+			if constexpr (!m_Stored) return;
+			else if constexpr (std::is_trivially_copyable_v<T>) {
+				for (ECS_SIZE_TYPE i = 0; i < count; i++) {
+					memcpy(dest + i * sizeof(T), src, sizeof(T));
+				}
+			}
+			else if constexpr (std::is_copy_constructible_v<T>) {
+				const T& value = *reinterpret_cast<const T*>(src);
+
+				for (ECS_SIZE_TYPE i = 0; i < count; i++) {
+					new (dest + i * sizeof(T)) T(value);
+				}
+			}
+			else {
+				LogFatal("Attempted to copy object of {}, but no available constructor", typeid(T).name());
+			}
+		}
+
 		void Swap(std::byte* a, std::byte* b) const override final {
-			// Allocate space to store a temporary
-			std::byte* tmp = new std::byte[sizeof(T)];
+			if constexpr (!m_Stored) return;
+
+			// Space to store a temporary (aligned, T may need more than new std::byte[] gives)
+			alignas(T) std::byte tmp[sizeof(T)];
 
-			// Some move shenanigans
+			// Some move shenanigans, destroying what was moved from (types that can only be copied would leak otherwise)
 			Assign(tmp, a);
+			Delete(a);
 			Assign(a,   b);
+			Delete(b);
 			Assign(b, tmp);
-			
-			delete[] tmp;
+			Delete(tmp);
 		}
 
 		std::size_t SizeInBytes() const override final {
-			return sizeof(T);
+			return m_Stored ? sizeof(T) : 0;
+		}
+
+		std::size_t AlignOf() const override final {
+			return alignof(T);
 		}
 
 		ECS_COMP_ID_TYPE GetComponentID() const override final {
 			return ComponentAllocator<T>::GetID();
 		}
 
+		bool InPlaceDelete() const override final {
+			return ComponentTraits<T>::in_place_delete;
+		}
+
+		bool UsesVirtualMemory() const override final {
+			return ComponentTraits<T>::virtual_memory;
+		}
+
+		bool DoubleBuffered() const override final {
+			return ComponentTraits<T>::double_buffered;
+		}
+
+		StoragePolicy Storage() const override final {
+			return ComponentTraits<T>::storage;
+		}
+
+		bool TriviallyCopyable() const override final {
+			return !m_Stored || std::is_trivially_copyable_v<T>;
+		}
+
+		ComponentAllocatorBase* Clone() const override final {
+			return new ComponentAllocator<T>{};
+		}
+
 		ComponentAllocator() = default;
 		~ComponentAllocator() {}
 
@@ -124,11 +218,24 @@ namespace ECS {
 	template <typename T>
 	const ECS_COMP_ID_TYPE ComponentAllocator<T>::m_ID = Family::Type<T>();
 
+	// Smallest amount of elements of T that covers whole cache lines of both pool arrays
+	// Pool arrays start on ECS_POOL_ALIGN, so ranges split at multiples of this never share a cache line between threads
+	template <typename T>
+	constexpr ECS_SIZE_TYPE CacheLineGranularity() {
+		constexpr ECS_SIZE_TYPE components = ECS_POOL_ALIGN / std::gcd<std::size_t, std::size_t>(sizeof(T), ECS_POOL_ALIGN);
+		constexpr ECS_SIZE_TYPE entities = ECS_POOL_ALIGN / std::gcd<std::size_t, std::size_t>(sizeof(Entity), ECS_POOL_ALIGN);
+
+		return std::lcm(components, entities);
+	}
+
 	class Registry;
 
 	struct ComponentPool {
 	private:
 		PagedArray<Entity, ECS_SPARSE_PAGE, ECS_ENTITY_MAX> m_SparseArray;
+		// Replaces m_SparseArray for StoragePolicy::Hashed, go through m_SparseGet/m_SparseSet rather than either directly
+		SparseHashMap m_SparseHash;
+		bool m_Hashed = false;
 
 		WrappedArray<Entity>	m_PackedArray;
 		WrappedArray<std::byte>	m_ComponentArray;
@@ -137,41 +244,241 @@ namespace ECS {
 
 		std::shared_ptr<GroupData> m_OwningGroup = nullptr;
 
+		// For pools with in-place deletion, the packed index of the first tombstone free for re-use
+		ECS_SIZE_TYPE m_FreeList = null_entity;
+		ECS_SIZE_TYPE m_Tombstones = 0;
+		bool m_InPlaceDelete = false;
+
+		// For pools using virtual memory, both arrays are reservations for ECS_ENTITY_MAX elements and this much of them is usable
+		bool m_VirtualMemory = false;
+		std::size_t m_CommittedPackedBytes = 0;
+		std::size_t m_CommittedComponentBytes = 0;
+
+		// Heap component arrays are aligned to this, ECS_POOL_ALIGN or alignof(T) if larger
+		std::size_t m_Alignment = ECS_POOL_ALIGN;
+
+		// Newest fork of the registry (if any), pages are saved into it before their first write since it was taken
+		PoolFork* m_Fork = nullptr;
+		std::uint32_t m_ForkEpoch = 0;
+		std::vector<std::uint32_t> m_PageVersions; // Epoch each page of ECS_PACKED_PAGE slots was last saved at
+
+		// For double-buffered pools, copies of every component as of some Flip, for readers on other threads
+		// Packed order can change between flips, so each keeps its own copy of the packed entities
+		struct FrontBuffer {
+			Entity* entities = nullptr; // dead_entity for slots without a component
+			std::byte* components = nullptr;
+			ECS_SIZE_TYPE size = 0;
+			ECS_SIZE_TYPE capacity = 0;
+			std::uint32_t generation = 0; // Holds every write made up to and including this generation
+			mutable std::atomic<std::uint32_t> readers = 0; // Front views pinning it, Flip never writes a pinned buffer
+		};
+
+		// Three buffers, the published one, one a slow reader may still be on, and a spare for Flip to bring up to date
+		static constexpr std::size_t m_FrontBufferCount = 3;
+
+		bool m_DoubleBuffered = false;
+		std::unique_ptr<FrontBuffer[]> m_FrontBuffers; // Only allocated for double-buffered pools
+		std::atomic<FrontBuffer*> m_Front = nullptr; // Newest published buffer, nullptr until the first Flip
+		std::uint32_t m_FlipGeneration = 1; // Writes made now belong to this generation, every published buffer is older
+		std::vector<std::uint32_t> m_PageWrites; // Generation each page of ECS_PACKED_PAGE slots was last written in, sized by Resize
+
+		// Changes whenever the arrays move or entities are added, removed or reordered (not when components are written to)
+		// Exports of the pool (see Registry::ExportPool) are only valid while it stays the same
+		// Starts at 1, 0 is what unregistered pools report
+		std::uint64_t m_LayoutEpoch = 1;
+
+		// Only incremented when ECS_ENABLE_STATS is set
+		struct {
+			std::uint64_t resizes = 0;
+			std::uint64_t swaps = 0;
+		} m_Counters;
+
+		// Packed index of entity, dead_entity if we don't have it (never allocates sparse pages)
+		inline ECS_SIZE_TYPE m_SparseGet(const Entity& entity) const {
+			if (m_Hashed) return m_SparseHash.Find(GetIdentifier(entity));
+
+			const ECS_SIZE_TYPE* slot = m_SparseArray.TryGet(GetIdentifier(entity));
+
+			return slot != nullptr ? *slot : dead_entity;
+		}
+
+		// Same, but T's storage policy picks the lookup at compile time
+		template <typename T>
+		inline ECS_SIZE_TYPE m_SparseGet(const Entity& entity) const {
+			if constexpr (ComponentTraits<T>::storage == StoragePolicy::Hashed) {
+				return m_SparseHash.Find(GetIdentifier(entity));
+			}
+			else {
+				const ECS_SIZE_TYPE* slot = m_SparseArray.TryGet(GetIdentifier(entity));
+
+				return slot != nullptr ? *slot : dead_entity;
+			}
+		}
+
+		// Point entity at index, dead_entity removes it
+		inline void m_SparseSet(const Entity& entity, const ECS_SIZE_TYPE& index) {
+			if (m_Hashed) {
+				if (index == dead_entity) { m_SparseHash.Erase(GetIdentifier(entity)); }
+				else { m_SparseHash.Set(GetIdentifier(entity), index); }
+
+				return;
+			}
+
+			m_SparseArray[GetIdentifier(entity)] = index;
+		}
+
+		// Both arrays start on a cache line, component storage honours alignof(T) (reservations are page aligned anyway)
+		Entity* m_AllocateEntities(const ECS_SIZE_TYPE& count);
+		std::byte* m_AllocateComponents(const ECS_SIZE_TYPE& count);
+		void m_FreeEntities(Entity* data);
+		void m_FreeComponents(std::byte* data);
+
 		void m_AllocatePackedSpace(const ECS_SIZE_TYPE& packed_index);
+		// Resize for pools using virtual memory, commits more of the reservation instead of copying
+		void m_Commit(ECS_SIZE_TYPE new_capacity);
+		inline std::size_t m_ReservedPackedBytes() const { return VirtualMemory::RoundToPage((ECS_ENTITY_MAX + 1) * sizeof(Entity)); }
+		inline std::size_t m_ReservedComponentBytes() const { return VirtualMemory::RoundToPage((ECS_ENTITY_MAX + 1) * m_Allocator->SizeInBytes()); }
+		// Find a slot for this entity (re-using a tombstone if we can), and add it to the sparse and packed arrays
+		ECS_SIZE_TYPE m_InsertEntity(const Entity& entity);
+		// Call deconstructor of every live component
+		void m_DeleteAll();
 
 		template <typename T>
 		T* m_Index(const ECS_SIZE_TYPE& index) {
 			return reinterpret_cast<T*>(&m_ComponentArray[index * m_Allocator->SizeInBytes()]);
 		}
 
+		// Location of the component for this entity, without knowing its type
+		std::byte* m_GetRawForEntity(const Entity& entity);
+		// Same, for reading only, so it doesn't touch the slot (see m_Touch)
+		const std::byte* m_ReadRawForEntity(const Entity& entity) const;
+		// Component of entity without touching its slot, callers that write through it must have touched it already
+		template <typename T>
+		T* m_FindComponent(const Entity& entity) const {
+			ECS_SIZE_TYPE packed_index = m_SparseGet<T>(entity);
+
+			if (packed_index == dead_entity) {
+				LogError("Attempted to index entity {} in pool type {}, but entity doesn't exist in this pool", entity, typeid(T).name());
+
+				return nullptr;
+			}
+
+			// Tags have no storage, any instance will do
+			if constexpr (ComponentTraits<T>::storage == StoragePolicy::Tag) {
+				static T tag{};
+
+				return &tag;
+			}
+			else {
+				return reinterpret_cast<T*>(m_ComponentArray.data + packed_index * m_Allocator->SizeInBytes());
+			}
+		}
+		// Add entity by moving a component of this pool's type from src
+		void m_PushRaw(const Entity& entity, std::byte* src);
+		// Add each of entities with a copy of prototype's component, the ones that don't re-use a tombstone end up next to each other
+		void m_PushCopies(const Entity& prototype, const Entity* entities, const ECS_SIZE_TYPE& count);
+		// Add entities as one block at the end, moving their components out of source's slots at source_indices (ascending)
+		// Runs of neighbouring source slots are moved with one AssignRange each
+		void m_PushMoved(const Entity* entities, ComponentPool* source, const ECS_SIZE_TYPE* source_indices, const ECS_SIZE_TYPE& count);
+		// Add entity by copying the bytes of a component from src, which needn't be aligned (trivially copyable components only)
+		void m_PushBytes(const Entity& entity, const std::byte* src);
+		// Has to be called before anything in the slot at index is written to (including handing out a non-const pointer)
+		inline void m_Touch(const ECS_SIZE_TYPE& index) {
+			if (m_DoubleBuffered) { m_PageWrites[index / ECS_PACKED_PAGE] = m_FlipGeneration; }
+
+			if (m_Fork == nullptr) return;
+
+			ECS_SIZE_TYPE page = index / ECS_PACKED_PAGE;
+
+			if (page >= m_PageVersions.size()) { m_PageVersions.resize(page + 1, 0); }
+
+			if (m_PageVersions[page] < m_ForkEpoch) { m_SavePage(page); }
+		}
+
+		// Same as m_Touch for every slot in [first, last)
+		void m_TouchRange(const ECS_SIZE_TYPE& first, const ECS_SIZE_TYPE& last);
+		void m_SavePage(const ECS_SIZE_TYPE& page);
+		// Put back the pages saved in forks (oldest first, forks.front() being the one to restore), and its sizes
+		void m_RestoreFork(const std::vector<PoolFork*>& forks, const std::uint32_t& epoch);
+		// Remove every component, keeping capacity
+		void m_Clear();
+		// Destroy a front buffer's components and free it
+		void m_DeleteFront(FrontBuffer& buffer);
+		// Give a front buffer room for capacity slots, moving what it holds (nothing may be reading it)
+		void m_GrowFront(FrontBuffer& buffer, const ECS_SIZE_TYPE& capacity);
+		// Pin the newest published front buffer so Flip leaves it alone, nullptr before the first Flip
+		// Lock free, a Flip publishing at the same time just makes us retry with the newer buffer
+		const FrontBuffer* m_AcquireFront() const;
+		inline void m_ReleaseFront(const FrontBuffer* buffer) const { buffer->readers.fetch_sub(1, std::memory_order_release); }
+
+		// Move these entities to the front of the pool in the given order, everything else keeps its relative order after them
+		void m_Reorder(const Entity* front, ECS_SIZE_TYPE count);
+		// Move the slots in [middle, last) in front of those in [first, middle), both keep their own order
+		// Only the range is touched and re-pointed in the sparse array, pointers into it are invalidated
+		void m_Rotate(const ECS_SIZE_TYPE& first, const ECS_SIZE_TYPE& middle, const ECS_SIZE_TYPE& last);
+
+		// Stages of the software prefetch pipeline for iterating by entity
+		inline void m_PrefetchSparse(const Entity& entity) const {
+			// Hashed pools are small enough to stay in cache
+			if (m_Hashed) return;
+
+			const ECS_SIZE_TYPE* slot = m_SparseArray.TryGet(GetIdentifier(entity));
+
+			if (slot != nullptr) { ECS_PREFETCH(slot); }
+		}
+
+		// Should be called after m_PrefetchSparse has had time to bring the sparse slot into cache
+		inline void m_PrefetchComponent(const Entity& entity) const {
+			ECS_SIZE_TYPE index = m_SparseGet(entity);
+
+			if (index != dead_entity) {
+				ECS_PREFETCH(m_ComponentArray.data + index * m_Allocator->SizeInBytes());
+			}
+		}
+
 		ECS_COMP_ID_TYPE m_ID = 0;
 
 	public:
+		// Over the raw component array (tombstones included), which is contiguous
 		template <typename T>
 		struct Iterator {
 		public:
-			using iterator_category = std::forward_iterator_tag;
+			using iterator_concept = std::contiguous_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
 			using difference_type = std::ptrdiff_t;
 			using value_type = T;
+			using element_type = T;
 			using pointer = value_type*;
 			using reference = value_type&;
 
 		private:
-			pointer m_Ptr;
+			pointer m_Ptr = nullptr;
 
 		public:
+			Iterator() = default;
 			Iterator(pointer ptr) : m_Ptr(ptr) {}
 
 			pointer& GetPtr() { return m_Ptr; }
 			
 			reference operator*() const { return *m_Ptr; }
-			pointer operator->() { return m_Ptr; }
+			pointer operator->() const { return m_Ptr; }
+			reference operator[](const difference_type& offset) const { return m_Ptr[offset]; }
 
 			Iterator& operator++() { m_Ptr++; return *this; }
 			Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+			Iterator& operator--() { m_Ptr--; return *this; }
+			Iterator operator--(int) { Iterator tmp = *this; --(*this); return tmp; }
+
+			Iterator& operator+=(const difference_type& offset) { m_Ptr += offset; return *this; }
+			Iterator& operator-=(const difference_type& offset) { m_Ptr -= offset; return *this; }
+
+			friend Iterator operator+(Iterator it, const difference_type& offset) { return it += offset; }
+			friend Iterator operator+(const difference_type& offset, Iterator it) { return it += offset; }
+			friend Iterator operator-(Iterator it, const difference_type& offset) { return it -= offset; }
+			friend difference_type operator-(const Iterator& a, const Iterator& b) { return a.m_Ptr - b.m_Ptr; }
 
 			friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_Ptr == b.m_Ptr; }
-			friend bool operator!=(const Iterator& a, const Iterator& b) { return a.m_Ptr != b.m_Ptr; }
+			friend auto operator<=>(const Iterator& a, const Iterator& b) { return a.m_Ptr <=> b.m_Ptr; }
 		};
 		
 		template <typename T>
@@ -181,7 +488,7 @@ namespace ECS {
 
 		template <typename T>
 		T* GetComponentForEntity(const Entity& entity) {
-			ECS_SIZE_TYPE packed_index = m_SparseArray[GetIdentifier(entity)];
+			ECS_SIZE_TYPE packed_index = m_SparseGet<T>(entity);
 
 			if (packed_index == dead_entity) {
 				LogError("Attempted to index entity {} in pool type {}, but entity doesn't exist in this pool", entity, typeid(T).name());
@@ -189,70 +496,67 @@ namespace ECS {
 				return nullptr;
 			}
 
-			return reinterpret_cast<T*>(&m_ComponentArray[packed_index * m_Allocator->SizeInBytes()]);
+			// Tags have no storage, any instance will do
+			if constexpr (ComponentTraits<T>::storage == StoragePolicy::Tag) {
+				static T tag{};
+
+				return &tag;
+			}
+			else {
+				// Caller may write through the pointer
+				m_Touch(packed_index);
+
+				return reinterpret_cast<T*>(&m_ComponentArray[packed_index * m_Allocator->SizeInBytes()]);
+			}
+		}
+
+		// Reading doesn't count as a write, so forks don't save the page and double-buffered pools don't mark it dirty
+		template <typename T>
+		const T* GetComponentForEntity(const Entity& entity) const {
+			return m_FindComponent<T>(entity);
 		}
 
 		template <typename T>
 		void Push(const Entity& entity, T&& comp) {
-			if (m_SparseArray[GetIdentifier(entity)] != dead_entity) {
+			if (m_SparseGet<T>(entity) != dead_entity) {
 				LogError("Entity {} already had component {}; can't push!", entity, typeid(T).name());
 
 				return;
 			}
 
-			// Update index to be at end of packed list
-			ECS_SIZE_TYPE packed_index = m_PackedArray.size;
-			m_SparseArray[GetIdentifier(entity)] = packed_index;
-
-			// Ensure enough space for this index
-			m_AllocatePackedSpace(packed_index);
-
-			// Add entity into packed array
-			m_PackedArray[packed_index] = entity;
+			// Get a slot for this entity
+			ECS_SIZE_TYPE packed_index = m_InsertEntity(entity);
 
 			// Add component into component array
 			std::byte* location = &m_ComponentArray[packed_index * m_Allocator->SizeInBytes()];
 
 			m_Allocator->Assign(location, reinterpret_cast<std::byte*>(&comp));
-
-			// Increment size of both arrays
-			++m_PackedArray.size;
-			++m_ComponentArray.size;
 		}
 
 		template <typename T, typename... Args>
 		void Emplace(const Entity& entity, Args&&... args) {
-			if (m_SparseArray[GetIdentifier(entity)] != dead_entity) {
+			if (m_SparseGet<T>(entity) != dead_entity) {
 				LogError("Entity {} already had component {}; can't push!", entity, typeid(T).name());
 
 				return;
 			}
 
-			// Update index to be at end of packed list
-			ECS_SIZE_TYPE packed_index = m_PackedArray.size;
-			m_SparseArray[GetIdentifier(entity)] = packed_index;
-
-			// Ensure enough space for this index
-			m_AllocatePackedSpace(packed_index);
-
-			// Add entity into packed array
-			m_PackedArray[packed_index] = entity;
+			// Get a slot for this entity
+			ECS_SIZE_TYPE packed_index = m_InsertEntity(entity);
 
 			// Get location for this index
 			std::byte* location = &m_ComponentArray[packed_index * m_Allocator->SizeInBytes()];
 
 			// Construct directly in that location (no allocation here)
-			new (location) T(args...);
-
-			// Increment size of both arrays
-			++m_PackedArray.size;
-			++m_ComponentArray.size;
+			if constexpr (ComponentTraits<T>::storage != StoragePolicy::Tag) {
+				new (location) T(args...);
+			}
 		}
 
 		template <typename T>
 		void Replace(const Entity& entity, T&& comp) {
 			// Get index of entity in sparse array
-			ECS_SIZE_TYPE& packed_index = m_SparseArray[GetIdentifier(entity)];
+			ECS_SIZE_TYPE packed_index = m_SparseGet<T>(entity);
 
 			// If entity doesn't exist
 			if (packed_index == dead_entity) {
@@ -263,6 +567,8 @@ namespace ECS {
 				return;
 			}
 
+			m_Touch(packed_index);
+
 			// Get location of component
 			std::byte* location = &m_ComponentArray[packed_index * m_Allocator->SizeInBytes()];
 
@@ -279,11 +585,26 @@ namespace ECS {
 
 		void Resize(ECS_SIZE_TYPE new_capacity);
 
+		// Give back memory past the last element, only pools using virtual memory can do this without copying
+		void ShrinkToFit();
+
+		// Move live components down into tombstones left by in-place deletion, invalidates pointers
+		void Compact();
+
+		// Publish the components as they are now to front views of a double-buffered pool
+		// Brings the least recent buffer nobody is reading up to date (only pages written to since it was last published), then swaps it in
+		// Never waits for readers, if slow ones hold both older buffers the last published one stays up until the next Flip
+		void Flip();
+
 		bool Contains(const Entity& entity);
 
 		inline bool HasExistingGroup() { return m_OwningGroup != nullptr; }
 
+		// Includes tombstones
 		ECS_SIZE_TYPE GetSize() const;
+		ECS_SIZE_TYPE GetTombstoneCount() const;
+
+		PoolStats Stats() const;
 
 		~ComponentPool();
 		ComponentPool(ComponentAllocatorBase* allocator);
@@ -296,9 +617,12 @@ namespace ECS {
 
 
 		friend class Registry;
+		friend class RuntimeView;
 
 		template <typename T>
 		friend class SingleView;
+		template <typename T>
+		friend class FrontView;
 		template <IsValidOwnershipTag... Ts>
 		friend class Group;
 	};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Core.h"
+
+namespace ECS {
+	// How a pool finds and stores components
+	enum class StoragePolicy {
+		Dense,	// Paged sparse array sized for every identifier, fastest lookups
+		Hashed,	// Hash map from identifier to packed index, memory follows how many entities have the component
+		Tag		// Only the set of entities is kept, components take no memory (for empty types)
+	};
+
+	// Specialise this for a component type to change how its pool stores it
+	template <typename T>
+	struct ComponentTraits {
+		// Removing a component leaves a tombstone rather than moving the last component into its slot,
+		// so pointers to components stay valid until the pool is resized or compacted
+		static constexpr bool in_place_delete = false;
+
+		// Reserve address space for ECS_ENTITY_MAX components up front and commit it as the pool grows,
+		// so resizing never copies and never moves components (see VirtualMemory.h)
+		static constexpr bool virtual_memory = false;
+
+		// Keep a second, read-only copy of the components that only changes on Registry::Flip,
+		// so other threads can read last frame's values while this frame's are being written
+		static constexpr bool double_buffered = false;
+
+		static constexpr StoragePolicy storage = StoragePolicy::Dense;
+	};
+}
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <algorithm>
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "Logger.h"
@@ -18,7 +21,8 @@
 #define ECS_SIZE_TYPE		std::uint32_t
 #define ECS_COMP_ID_TYPE	std::uint32_t // TODO: really should be uint8_t
 #define ECS_SPARSE_PAGE		4096U
-#define ECS_PACKED_PAGE		1024U	 // TODO: unused (packed arrays aren't paged)
+#define ECS_PACKED_PAGE		1024U	 // Slots per page that forks save and Flip copies (packed arrays themselves aren't paged)
+#define ECS_SPARSE_HASH_MIN	16U		 // Starting slot count of hashed pools' sparse maps (StoragePolicy::Hashed)
 #define ECS_ENTITY_MAX		0xfffffU // 5 * 4 bits (20)
 #define ECS_VERSION_MAX		0xfffU   // 3 * 4 bits (12)
 
@@ -31,3 +35,45 @@
 #define ECS_VERSION_BITMASK     0b11111111111100000000000000000000U
 
 #define ECS_POOL_RESIZE_FACTOR  2
+// Packed and component arrays of pools start on this boundary (or alignof(T) if larger), keep it a power of two
+#define ECS_POOL_ALIGN			64U
+
+// Runtime statistics counters (Registry::Stats, ComponentPool::Stats), set to 0 to compile them out
+#ifndef ECS_ENABLE_STATS
+#define ECS_ENABLE_STATS		1
+#endif
+
+#if ECS_ENABLE_STATS
+#define ECS_STAT(expr) expr
+#else
+#define ECS_STAT(expr)
+#endif
+
+// Scoped trace zones for Trace::DumpChromeTrace, set to 1 to compile them in
+#ifndef ECS_ENABLE_TRACING
+#define ECS_ENABLE_TRACING		0
+#endif
+
+#define ECS_TRACE_BUFFER_SIZE	16384U // Events kept per thread, older events get overwritten
+
+// Bytes per chunk of an archetype (ArchetypeRegistry), chunks hold as many entities of one archetype as fit
+#define ECS_ARCHETYPE_CHUNK_SIZE	16384U
+#define ECS_ARCHETYPE_CHUNK_ALIGN	64U // Chunks start on a cache line
+
+// Ask for transparent huge pages on pools using virtual memory (ComponentTraits<T>::virtual_memory)
+#ifndef ECS_VIRTUAL_MEMORY_HUGE_PAGES
+#define ECS_VIRTUAL_MEMORY_HUGE_PAGES	0
+#endif
+
+// Owning groups created over at least this many entities partition each owned pool on its own thread
+#define ECS_PARALLEL_PARTITION_MIN	16384U
+
+// How many entities ahead partial iteration starts resolving sparse indices (component addresses are resolved half as far ahead)
+#define ECS_PREFETCH_DISTANCE	8U
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define ECS_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define ECS_PREFETCH(address) __builtin_prefetch(address)
+#endif
@@ -2,6 +2,10 @@
 
 #include "View.h"
 #include "Group.h"
+#include "CommandBuffer.h"
+#include "ArchetypeView.h"
+#include "StaticRegistry.h"
+#include "RuntimeView.h"
 
 // TODO: needs extensive testing that GetIdentifier is being used appropriately
 // TODO: multiple assumptions that the identifier is the first 20 bits
@@ -33,4 +33,16 @@ namespace ECS {
 	static constexpr Entity null_entity			= entity_max_value & ECS_ENTITY_BITMASK;
 	static constexpr Entity tomb_entity			= entity_max_value & ECS_VERSION_BITMASK;
 	static constexpr Entity dead_entity			= entity_max_value; // Completely dead entity
+
+	// Tombstones in a packed array have every version bit set, the identifier bits link to the next free slot
+	inline bool IsTombstone(const Entity& entity) {
+		return (entity & ECS_VERSION_BITMASK) == tomb_entity;
+	}
+
+	// Next version of a recycled entity, skipping the tombstone version (which a live entity must never have)
+	inline void IncrementVersion(Entity& entity) {
+		AddValueToVersion(entity, 1);
+
+		if (IsTombstone(entity)) { entity = GetIdentifier(entity); }
+	}
 }
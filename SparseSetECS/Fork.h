@@ -0,0 +1,66 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "Core.h"
+#include "Entity.h"
+#include "SharedComponent.h"
+
+namespace ECS {
+	class ComponentAllocatorBase;
+	struct GroupData;
+
+	// Frees memory from an aligned operator new
+	struct AlignedDelete {
+		std::size_t alignment = alignof(std::max_align_t);
+
+		void operator()(std::byte* data) const { ::operator delete(data, std::align_val_t(alignment)); }
+	};
+
+	// What a component pool looked like when a fork was taken
+	// Pages (ECS_PACKED_PAGE slots) are only copied in here right before they are first written to after the fork
+	struct PoolFork {
+		// Copies are made in memory aligned like the pool's
+		using Components = std::unique_ptr<std::byte[], AlignedDelete>;
+
+		struct Page {
+			std::unique_ptr<Entity[]> entities; // Tombstones and dead_entity mark slots without a component
+			Components components; // Copies of the live components
+		};
+
+		ComponentAllocatorBase* allocator = nullptr; // The pool's, for destroying the copies
+		std::unordered_map<ECS_SIZE_TYPE, Page> pages;
+
+		ECS_SIZE_TYPE size = 0;
+		ECS_SIZE_TYPE free_list = null_entity;
+		ECS_SIZE_TYPE tombstones = 0;
+
+		// Owning group of the pool at the time, and its bounds
+		GroupData* group = nullptr;
+		ECS_SIZE_TYPE group_start = 0;
+		ECS_SIZE_TYPE group_end = 0;
+
+		PoolFork(ComponentAllocatorBase* allocator) : allocator(allocator) {}
+		~PoolFork();
+
+		PoolFork(const PoolFork& other) = delete;
+		PoolFork& operator=(const PoolFork& other) = delete;
+	};
+
+	// Copy-on-write snapshot of a registry, made by Registry::Fork
+	// Costs nothing until the registry is written to, then one page copy per page on its first write
+	struct RegistryFork {
+		std::uint32_t epoch = 0; // Pages last saved before this need saving on their next write
+
+		std::array<std::unique_ptr<PoolFork>, ECS_MAX_COMPONENTS> pools; // nullptr for pools created after the fork
+		std::unordered_map<ECS_SIZE_TYPE, std::unique_ptr<Signature[]>> signature_pages; // Pages of ECS_SPARSE_PAGE signatures
+		std::unordered_map<ECS_SIZE_TYPE, std::unique_ptr<Entity[]>> entity_pages; // Pages of ECS_PACKED_PAGE entities in use
+		std::array<std::unique_ptr<SharedTableBase>, ECS_MAX_COMPONENTS> shared_tables; // Copied whole when the fork is taken
+
+		Entity next_entity = ECS_ENTITY_MAX;
+		Entity next_largest_entity = 0;
+		ECS_SIZE_TYPE available_entities = 0;
+		std::size_t entities_in_use = 0;
+		bool hierarchy_dirty = false;
+	};
+}
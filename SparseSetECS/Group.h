@@ -10,105 +10,130 @@ namespace ECS {
 		Registry* m_Registry;
 		ComponentPool* m_IteratingPool = nullptr; // The pool we iterate, will be any owned component pool
 		bool m_OwnsField = false;
+		// Pool of each of WrappedTypes, in the same order, so iterating doesn't look them up per entity
+		std::array<ComponentPool*, sizeof...(WrappedTypes)> m_TypePools;
 
 		template <typename T>
-		typename T::type* m_Grab(ECS_SIZE_TYPE index, Entity entity) {
-			ECS_COMP_ID_TYPE id = ComponentAllocator<typename T::type>::GetID();
-			ComponentPool* pool = m_Registry->m_Pools[id];
-
+		static typename T::type* m_Grab(ComponentPool* pool, ECS_SIZE_TYPE index, Entity entity) {
 			// If its an owned component
 			if constexpr (IsOwnedTag<T>) {
-				return pool->m_Index<typename T::type>(index);
+				return reinterpret_cast<typename T::type*>(pool->m_ComponentArray.data) + index;
 			}
-			// If partially owned component
+			// If partially owned component (begin touched the whole pool unless it's const, so this is safe from several threads at once)
 			else {
-				return pool->GetComponentForEntity<typename T::type>(entity);
+				return pool->m_FindComponent<typename T::component>(entity);
 			}
 		}
 
-		using tuple_type = std::tuple<Entity, typename WrappedTypes::type*...>;
+		template <typename T>
+		static void m_PrefetchSparse(ComponentPool* pool, const Entity& entity) {
+			if constexpr (IsPartialTag<T>) {
+				pool->m_PrefetchSparse(entity);
+			}
+		}
 
-		tuple_type m_GetIndex(ECS_SIZE_TYPE& index) {
-			bool valid_entity = false;
-			Entity* entity = nullptr;
+		template <typename T>
+		static void m_PrefetchComponent(ComponentPool* pool, const Entity& entity) {
+			if constexpr (IsPartialTag<T>) {
+				pool->m_PrefetchComponent(entity);
+			}
+		}
 
-			do {
-				// Kind of a soft error when we try to grab end()
-				if (index >= m_GroupData->end_index || index >= m_IteratingPool->GetSize()) {
-					return tuple_type{};
-				}
+		// Entities we iterate, the owned pools' packed array, or our own member list if we don't own anything
+		inline const Entity* m_Entities() {
+			return m_OwnsField ? m_IteratingPool->m_PackedArray.data : m_GroupData->members.data();
+		}
 
-				entity = &(m_IteratingPool->m_PackedArray[index]);
+		// Partial components are found through the sparse array, which stalls on two dependent cache misses per entity
+		// So resolve sparse slots ECS_PREFETCH_DISTANCE entities ahead, and component addresses half that far ahead
+		template <std::size_t... Is>
+		void m_Prefetch(const ECS_SIZE_TYPE& index, std::index_sequence<Is...>) {
+			if constexpr ((IsPartialTag<WrappedTypes> || ...)) {
+				const Entity* entities = m_Entities();
+				ECS_SIZE_TYPE size = m_GroupData->end_index;
 
-				// We have to check ourselves that the entity actually has all the components
-				if (!m_OwnsField) {
-					// Get entity signature
-					Signature& signature = m_Registry->m_Signatures[GetIdentifier(*entity)];
-					// If this entity didn't contain all the signatures
-					if (!m_GroupData->ContainsSignature(signature)) {
-						// Increment index again
-						++index;
-					}
-					// It did contain all the signatures
-					else {
-						valid_entity = true;
-					}
+				if (index + ECS_PREFETCH_DISTANCE < size) {
+					const Entity& entity = entities[index + ECS_PREFETCH_DISTANCE];
+
+					(m_PrefetchSparse<WrappedTypes>(m_TypePools[Is], entity), ...);
 				}
-				// We are already assured this entity contains all the components
-				else {
-					valid_entity = true;
+
+				if (index + ECS_PREFETCH_DISTANCE / 2 < size) {
+					const Entity& entity = entities[index + ECS_PREFETCH_DISTANCE / 2];
+
+					(m_PrefetchComponent<WrappedTypes>(m_TypePools[Is], entity), ...);
 				}
-			} while (!valid_entity);
+			}
+		}
+
+		using tuple_type = std::tuple<Entity, typename WrappedTypes::type*...>;
+
+		template <std::size_t... Is>
+		tuple_type m_GetIndex(const ECS_SIZE_TYPE& index, std::index_sequence<Is...> sequence) {
+			// Kind of a soft error when we try to grab end()
+			if (index >= m_GroupData->end_index) {
+				return tuple_type{};
+			}
+
+			// Every entity in range is already assured to contain all the components
+			Entity entity = m_Entities()[index];
+
+			m_Prefetch(index, sequence);
 
-			return std::make_tuple<Entity, typename WrappedTypes::type*...>(
-				std::forward<Entity>(*entity), m_Grab<WrappedTypes>(index, *entity)...
-			);
+			return tuple_type(entity, m_Grab<WrappedTypes>(m_TypePools[Is], index, entity)...);
+		}
+
+		inline tuple_type m_GetIndex(const ECS_SIZE_TYPE& index) {
+			return m_GetIndex(index, std::index_sequence_for<WrappedTypes...>{});
 		}
 
 	public:
+		// Random access for std::ranges, so ranges of a group can be split between threads
+		// Dereferencing builds the tuple of pointers on the spot and returns it by value, which only makes it an input iterator to legacy algorithms
+		// Writing through the pointers is fine, but don't sort or otherwise permute through these iterators, assigning to a temporary tuple changes nothing
 		struct Iterator {
 		public:
-			using iterator_category = std::forward_iterator_tag;
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
 			using difference_type = std::ptrdiff_t;
 			using value_type = tuple_type;
-			using pointer = value_type*;
-			using reference = value_type&;
+			using reference = value_type;
 
 		private:
-			Group<WrappedTypes...>* m_Group;
+			Group<WrappedTypes...>* m_Group = nullptr;
 			ECS_SIZE_TYPE m_Index = 0;
-			value_type m_Current;
 
 		public:
+			Iterator() = default;
 			Iterator(Group* group, const ECS_SIZE_TYPE& index)
-				: m_Index(index), m_Group(group)
-			{
-				m_Current = m_Group->m_GetIndex(m_Index);
-			}
+				: m_Group(group), m_Index(index)
+			{}
 
-			reference operator*() { return m_Current; }
-			pointer operator->() { return &m_Current; }
+			reference operator*() const { return m_Group->m_GetIndex(m_Index); }
+			reference operator[](const difference_type& offset) const { return m_Group->m_GetIndex(static_cast<ECS_SIZE_TYPE>(m_Index + offset)); }
 
-			Iterator& operator++() {
-				++m_Index;
+			Iterator& operator++() { ++m_Index; return *this; }
+			Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+			Iterator& operator--() { --m_Index; return *this; }
+			Iterator operator--(int) { Iterator tmp = *this; --(*this); return tmp; }
 
-				m_Current = m_Group->m_GetIndex(m_Index);
+			Iterator& operator+=(const difference_type& offset) { m_Index = static_cast<ECS_SIZE_TYPE>(m_Index + offset); return *this; }
+			Iterator& operator-=(const difference_type& offset) { m_Index = static_cast<ECS_SIZE_TYPE>(m_Index - offset); return *this; }
 
-				return *this;
-			}
-			Iterator operator++(int) {
-				Iterator tmp = *this;
-
-				++(*this);
-				return tmp;
+			friend Iterator operator+(Iterator it, const difference_type& offset) { return it += offset; }
+			friend Iterator operator+(const difference_type& offset, Iterator it) { return it += offset; }
+			friend Iterator operator-(Iterator it, const difference_type& offset) { return it -= offset; }
+			friend difference_type operator-(const Iterator& a, const Iterator& b) {
+				return static_cast<difference_type>(a.m_Index) - static_cast<difference_type>(b.m_Index);
 			}
 
 			friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_Index == b.m_Index; }
-			friend bool operator!=(const Iterator& a, const Iterator& b) { return a.m_Index != b.m_Index; }
+			friend auto operator<=>(const Iterator& a, const Iterator& b) { return a.m_Index <=> b.m_Index; }
 		};
 
 		Group(Registry* registry, std::shared_ptr<GroupData> data, ComponentPool* iterating_pool, bool owns_field)
-			: m_GroupData(data), m_Registry(registry), m_IteratingPool(iterating_pool), m_OwnsField(owns_field)
+			: m_GroupData(data), m_Registry(registry), m_IteratingPool(iterating_pool), m_OwnsField(owns_field),
+			m_TypePools{ registry->m_Pools[ComponentAllocator<typename WrappedTypes::component>::GetID()]... }
 		{}
 
 		~Group() {
@@ -117,26 +142,29 @@ namespace ECS {
 			}
 		}
 
-		Iterator begin() { return Iterator(this, m_GroupData->start_index); }
-		Iterator end()
-		{
-			if (m_OwnsField) {
-				return Iterator(this, m_GroupData->end_index);
-			}
-			else {
-				ECS_SIZE_TYPE max_index = 0;
-
-				// Reverse iterating pool
-				for (ECS_SIZE_TYPE index = m_IteratingPool->GetSize() - 1; index >= 0; index--) {
-					// Get entity at index
-					Entity& entity = m_IteratingPool->m_PackedArray[index];
-					Signature& signature = m_Registry->m_Signatures[GetIdentifier(entity)];
+		Iterator begin() {
+			// Non-const components handed out may be written to, so touch them all here rather than per entity while iterating
+			// Owned ones are the group's range, partial ones are scattered over their whole pool
+			// Const ones are only read, so they leave fork and dirty pages alone
+			([&] {
+				if constexpr (!std::is_const_v<typename WrappedTypes::type>) {
+					ComponentPool* pool = m_Registry->m_Pools[ComponentAllocator<typename WrappedTypes::component>::GetID()];
 
-					if (m_GroupData->ContainsSignature(signature)) { max_index = index; break; }
+					if constexpr (IsOwnedTag<WrappedTypes>) {
+						pool->m_TouchRange(m_GroupData->start_index, m_GroupData->end_index);
+					}
+					else {
+						pool->m_TouchRange(0, pool->GetSize());
+					}
 				}
+			} (), ...);
 
-				return Iterator(this, max_index + 1);
-			}
+			return Iterator(this, m_GroupData->start_index);
+		}
+
+		Iterator end()
+		{
+			return Iterator(this, m_GroupData->end_index);
 		}
 
 		inline ECS_SIZE_TYPE size() { return m_GroupData->end_index - m_GroupData->start_index; }
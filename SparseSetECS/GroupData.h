@@ -2,12 +2,14 @@
 
 #include "Core.h"
 #include "Entity.h"
+#include "PagedArray.h"
 
 namespace ECS {
+	// Owned<const T>/Partial<const T> hand out const pointers, and iterating doesn't count as writing to T (see ComponentPool::m_Touch)
 	template <typename T>
-	struct Owned { using type = T; using owned_tag = std::true_type; using partial_tag = std::false_type; };
+	struct Owned { using type = T; using component = std::remove_const_t<T>; using owned_tag = std::true_type; using partial_tag = std::false_type; };
 	template <typename T>
-	struct Partial { using type = T; using owned_tag = std::false_type; using partial_tag = std::true_type; };
+	struct Partial { using type = T; using component = std::remove_const_t<T>; using owned_tag = std::false_type; using partial_tag = std::true_type; };
 
 	template <typename T>
 	concept IsValidOwnershipTag = requires (T) {
@@ -29,13 +31,17 @@ namespace ECS {
 		Signature partial_components;
 		Signature affected_components;
 
-		GroupData() = default;
+		// Non-owning groups don't reorder any pool, so they keep their own sparse set of matching entities
+		std::vector<Entity> members;
+		PagedArray<ECS_SIZE_TYPE, ECS_SPARSE_PAGE, ECS_ENTITY_MAX> member_indices;
+
+		GroupData() { member_indices.SetDefault(dead_entity); }
 
 		template <IsValidOwnershipTag... WrappedTypes>
 		void Init() {
 			// Setup our signatures
 			([&] {
-				ECS_COMP_ID_TYPE id = ComponentAllocator<typename WrappedTypes::type>::GetID();
+				ECS_COMP_ID_TYPE id = ComponentAllocator<typename WrappedTypes::component>::GetID();
 				affected_components.set(id, true);
 				
 				// Owned types
@@ -49,6 +55,45 @@ namespace ECS {
 			} (), ...);
 		}
 
+		inline bool IsOwning() const {
+			return owned_components.any();
+		}
+
+		inline bool HasMember(const Entity& entity) const {
+			return member_indices[GetIdentifier(entity)] != dead_entity;
+		}
+
+		void AddMember(const Entity& entity) {
+			member_indices[GetIdentifier(entity)] = static_cast<ECS_SIZE_TYPE>(members.size());
+			members.push_back(entity);
+
+			++end_index;
+		}
+
+		void RemoveMember(const Entity& entity) {
+			ECS_SIZE_TYPE& index = member_indices[GetIdentifier(entity)];
+			Entity last_entity = members.back();
+
+			// Swap and pop
+			members[index] = last_entity;
+			member_indices[GetIdentifier(last_entity)] = index;
+			members.pop_back();
+
+			index = dead_entity;
+
+			--end_index;
+		}
+
+		// Forget every member, keeping memory of member_indices
+		void ClearMembers() {
+			for (const Entity& entity : members) {
+				member_indices[GetIdentifier(entity)] = dead_entity;
+			}
+
+			members.clear();
+			end_index = start_index;
+		}
+
 		inline bool OwnsID(ECS_COMP_ID_TYPE id) {
 			return owned_components.test(id);
 		}
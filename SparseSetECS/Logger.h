@@ -1,11 +1,17 @@
 // Just ripped off TwashiUtils
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <format>
 #include <iostream>
+#include <memory>
+#include <new>
 #include <string>
-#include <regex>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 
 #define TWASHI_LOG_TRACE 0
 #define TWASHI_LOG_INFO  1
@@ -13,35 +19,276 @@
 #define TWASHI_LOG_ERROR 3
 #define TWASHI_LOG_FATAL 4
 
-#define LogFatal(msg, ...)	Logger::__LogBase(std::format(msg, __VA_ARGS__), __LINE__, __FUNCSIG__, "Fatal", TWASHI_LOG_FATAL)
-#define LogError(msg, ...)	Logger::__LogBase(std::format(msg, __VA_ARGS__), __LINE__, __FUNCSIG__, "Error", TWASHI_LOG_ERROR)
-#define LogWarn(msg, ...)	Logger::__LogBase(std::format(msg, __VA_ARGS__), __LINE__, __FUNCSIG__, "Warn",  TWASHI_LOG_WARN )
-#define LogInfo(msg, ...)	Logger::__LogBase(std::format(msg, __VA_ARGS__), __LINE__, __FUNCSIG__, "Info",  TWASHI_LOG_INFO )
-#define LogTrace(msg, ...)	Logger::__LogBase(std::format(msg, __VA_ARGS__), __LINE__, __FUNCSIG__, "Trace", TWASHI_LOG_TRACE)
+// Calls below this level are compiled out entirely (arguments aren't even evaluated)
+#ifndef TWASHI_LOG_LEVEL
+#define TWASHI_LOG_LEVEL TWASHI_LOG_TRACE
+#endif
+
+// Message slots waiting to be written, a power of two, logging waits for a free one when they're all taken
+#define TWASHI_LOG_QUEUE_SIZE 1024
+// Bytes of copied arguments a slot holds, calls with bigger arguments are formatted on the calling thread instead
+#define TWASHI_LOG_ARGS_SIZE 128
+
+// Fatal is never filtered, since it has to exit
+#define LogFatal(msg, ...)	Logger::__LogFatal(msg, __VA_ARGS__)
+
+#if TWASHI_LOG_LEVEL <= TWASHI_LOG_ERROR
+#define LogError(msg, ...)	Logger::__LogAsync("Error", msg, __VA_ARGS__)
+#else
+#define LogError(msg, ...)	((void)0)
+#endif
+
+#if TWASHI_LOG_LEVEL <= TWASHI_LOG_WARN
+#define LogWarn(msg, ...)	Logger::__LogAsync("Warn",  msg, __VA_ARGS__)
+#else
+#define LogWarn(msg, ...)	((void)0)
+#endif
+
+#if TWASHI_LOG_LEVEL <= TWASHI_LOG_INFO
+#define LogInfo(msg, ...)	Logger::__LogAsync("Info",  msg, __VA_ARGS__)
+#else
+#define LogInfo(msg, ...)	((void)0)
+#endif
+
+#if TWASHI_LOG_LEVEL <= TWASHI_LOG_TRACE
+#define LogTrace(msg, ...)	Logger::__LogAsync("Trace", msg, __VA_ARGS__)
+#else
+#define LogTrace(msg, ...)	((void)0)
+#endif
 
 namespace Logger {
-	static constexpr int LOG_LEVEL = TWASHI_LOG_TRACE;
+	static constexpr int LOG_LEVEL = TWASHI_LOG_LEVEL;
 
-	void __LogBase(const std::string msg, int line, const char* func_sig, const char* severity_text, int severity)
-#ifdef TWASHI_LOGGER_IMPLEMENTATION
-		// Definition
-	{
-		if (severity < LOG_LEVEL) return;
+	// Slot of the message queue, arguments are copied into it and only formatted on the logging thread
+	struct __Message {
+		alignas(std::max_align_t) std::byte args[TWASHI_LOG_ARGS_SIZE];
+		std::string(*format)(std::string_view text, std::byte* args) = nullptr; // Formats the arguments, then destroys them
+		std::string_view text; // Format string (a literal, so it outlives the message)
+		std::chrono::system_clock::time_point time;
+		const char* severity_text = nullptr;
+
+		std::size_t position = 0; // Where in the queue this slot was claimed
+		std::atomic<std::size_t> sequence = 0; // Whether the slot is free, or written and waiting for the logging thread
+	};
 
-		const std::regex cleaner("");
-		std::string function_cleaned = std::regex_replace(func_sig, cleaner, "");
+	// Take a free slot, blocks (in wait(), not spinning) while every slot is waiting to be written
+	__Message* __Claim();
+	// Hand a claimed slot over to the logging thread (lock-free, never blocks on stdout)
+	void __Push(__Message* message);
+	// Block until every pushed message has been written
+	void Flush();
+
+	template <typename Stored>
+	std::string __FormatStored(std::string_view text, std::byte* args) {
+		Stored* stored = std::launder(reinterpret_cast<Stored*>(args));
+
+		std::string formatted = std::apply([&](auto&... values) { return std::vformat(text, std::make_format_args(values...)); }, *stored);
+
+		stored->~Stored();
+
+		return formatted;
+	}
+
+	// Copying these into a slot only copies a pointer to characters the caller may free before the logging thread formats them
+	// (std::string is safe but allocates to copy, so it's no better than formatting)
+	template <typename T>
+	inline constexpr bool __DeferrableArg = !std::is_same_v<T, const char*> && !std::is_same_v<T, char*>
+		&& !std::is_same_v<T, std::string_view> && !std::is_same_v<T, std::string>;
+
+	// Arguments are copied into a queue slot now (no allocation of our own), but only formatted on the logging thread
+	// Strings are the exception, see __DeferrableArg
+	// Format strings are checked at compile time
+	template <typename... Args>
+	void __LogAsync(const char* severity_text, std::format_string<Args...> msg, Args&&... args) {
+		using Stored = std::tuple<std::decay_t<Args>...>;
+
+		__Message* message = __Claim();
+
+		if constexpr ((__DeferrableArg<std::decay_t<Args>> && ...) && sizeof(Stored) <= TWASHI_LOG_ARGS_SIZE && alignof(Stored) <= alignof(std::max_align_t)) {
+			new (message->args) Stored(std::forward<Args>(args)...);
+
+			message->format = &__FormatStored<Stored>;
+			message->text = msg.get();
+		}
+		// Arguments don't fit or can't wait, so store the formatted message instead
+		else {
+			new (message->args) std::tuple<std::string>(std::vformat(msg.get(), std::make_format_args(args...)));
+
+			message->format = &__FormatStored<std::tuple<std::string>>;
+			message->text = "{}";
+		}
+
+		message->time = std::chrono::system_clock::now();
+		message->severity_text = severity_text;
+
+		__Push(message);
+	}
+
+	// Fatal errors are written synchronously, after everything before them, then exit
+	template <typename... Args>
+	[[noreturn]] void __LogFatal(std::format_string<Args...> msg, Args&&... args) {
+		Flush();
 
 		std::cout << std::format(
 			"[{}] {}: {}",
 			std::format("{:%H:%M:%OS}", std::chrono::system_clock::now()),
-			severity_text,
-			msg
+			"Fatal",
+			std::format(msg, std::forward<Args>(args)...)
 		) << std::endl;
 
-		if (severity == TWASHI_LOG_FATAL) { exit(EXIT_FAILURE); }
+		exit(EXIT_FAILURE);
 	}
-#else
-		// Forward decl (pretty cheaty)
-		;
+
+#ifdef TWASHI_LOGGER_IMPLEMENTATION
+	// Bounded multiple producer queue of message slots (Dmitry Vyukov's design), with a single consumer
+	// A slot's sequence is its position while free, and its position + 1 once written
+	class __Worker {
+	private:
+		std::unique_ptr<__Message[]> m_Slots;
+		std::atomic<std::size_t> m_EnqueuePosition = 0;
+		std::size_t m_DequeuePosition = 0; // Only touched by the logging thread
+
+		std::atomic<std::uint32_t> m_Pending = 0; // Pushed but not yet written
+		std::atomic<bool> m_Running = true;
+		std::thread m_Thread;
+
+		static constexpr std::size_t m_Mask = TWASHI_LOG_QUEUE_SIZE - 1;
+		static_assert((TWASHI_LOG_QUEUE_SIZE & m_Mask) == 0, "TWASHI_LOG_QUEUE_SIZE has to be a power of two");
+
+		// Only called from the logging thread, nullptr if the oldest slot isn't written yet
+		__Message* m_Dequeue() {
+			__Message* message = &m_Slots[m_DequeuePosition & m_Mask];
+
+			if (message->sequence.load(std::memory_order_acquire) != m_DequeuePosition + 1) return nullptr;
+
+			return message;
+		}
+
+		// Give the slot back to producers, a whole lap of the queue later
+		void m_Release(__Message* message) {
+			message->sequence.store(m_DequeuePosition + TWASHI_LOG_QUEUE_SIZE, std::memory_order_release);
+			// Producers may be blocked in Claim on a full queue
+			message->sequence.notify_all();
+			++m_DequeuePosition;
+		}
+
+		void m_Run() {
+			while (true) {
+				std::uint32_t pending = m_Pending.load(std::memory_order_acquire);
+
+				if (pending == 0) {
+					// Sleep until something is pushed (or we are told to stop)
+					m_Pending.wait(0, std::memory_order_acquire);
+
+					continue;
+				}
+
+				// Write everything available, then flush once
+				__Message* message;
+				std::uint32_t written = 0;
+
+				while ((message = m_Dequeue()) != nullptr) {
+					std::cout << std::format(
+						"[{}] {}: {}",
+						std::format("{:%H:%M:%OS}", message->time),
+						message->severity_text,
+						message->format(message->text, message->args)
+					) << '\n';
+
+					m_Release(message);
+					++written;
+				}
+
+				std::cout.flush();
+
+				if (written > 0) {
+					m_Pending.fetch_sub(written, std::memory_order_acq_rel);
+					m_Pending.notify_all();
+				}
+				// Nothing left to write and we've been told to stop
+				else if (!m_Running.load(std::memory_order_acquire)) {
+					break;
+				}
+				// Something later was pushed, but the oldest slot is claimed and not yet written, sleep until its producer pushes it
+				else {
+					m_Slots[m_DequeuePosition & m_Mask].sequence.wait(m_DequeuePosition, std::memory_order_acquire);
+				}
+			}
+		}
+
+	public:
+		__Worker() : m_Slots(new __Message[TWASHI_LOG_QUEUE_SIZE]) {
+			for (std::size_t index = 0; index < TWASHI_LOG_QUEUE_SIZE; index++) {
+				m_Slots[index].sequence.store(index, std::memory_order_relaxed);
+			}
+
+			m_Thread = std::thread(&__Worker::m_Run, this);
+		}
+
+		~__Worker() {
+			Flush();
+
+			m_Running.store(false, std::memory_order_release);
+			// Wake the thread so it sees we've stopped
+			m_Pending.fetch_add(1, std::memory_order_acq_rel);
+			m_Pending.notify_all();
+
+			m_Thread.join();
+		}
+
+		__Message* Claim() {
+			std::size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+
+			while (true) {
+				__Message* message = &m_Slots[position & m_Mask];
+				std::size_t sequence = message->sequence.load(std::memory_order_acquire);
+
+				if (sequence == position) {
+					if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						message->position = position;
+
+						return message;
+					}
+				}
+				// Every slot is waiting to be written, sleep until the logging thread releases this one
+				else if (sequence < position) {
+					message->sequence.wait(sequence, std::memory_order_acquire);
+
+					position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				}
+				// Another producer took this slot first
+				else {
+					position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		void Push(__Message* message) {
+			message->sequence.store(message->position + 1, std::memory_order_release);
+			// The logging thread may be waiting on this slot, if later ones were pushed first
+			message->sequence.notify_one();
+
+			m_Pending.fetch_add(1, std::memory_order_acq_rel);
+			m_Pending.notify_one();
+		}
+
+		void Flush() {
+			std::uint32_t pending;
+
+			while ((pending = m_Pending.load(std::memory_order_acquire)) != 0) {
+				m_Pending.wait(pending, std::memory_order_acquire);
+			}
+		}
+	};
+
+	static __Worker& __GetWorker() {
+		static __Worker worker;
+
+		return worker;
+	}
+
+	__Message* __Claim() { return __GetWorker().Claim(); }
+	void __Push(__Message* message) { __GetWorker().Push(message); }
+	void Flush() { __GetWorker().Flush(); }
 #endif
-}
\ No newline at end of file
+}
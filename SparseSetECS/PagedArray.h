@@ -64,7 +64,7 @@ namespace ECS {
 			ECS_SIZE_TYPE index_in_page = index - (page_index * m_PageSize);
 
 			// Get the relevant page
-			page_type& page = m_GetPage(page_index);
+			const page_type& page = m_Book[page_index];
 
 			if (page != nullptr) {
 				return page[index_in_page];
@@ -77,10 +77,28 @@ namespace ECS {
 	public:
 		static const ECS_SIZE_TYPE GetCapacity()  { return m_Capacity; }
 		static const ECS_SIZE_TYPE GetPageCount() { return m_Pages; }
+		static const std::size_t GetPageSizeInBytes() { return m_PageSize * sizeof(T); }
+
+		// Amount of pages that have actually been allocated
+		ECS_SIZE_TYPE GetResidentPageCount() const {
+			return static_cast<ECS_SIZE_TYPE>(std::count_if(m_Book.begin(), m_Book.end(), [](const page_type& page) { return page != nullptr; }));
+		}
 
 		void SetDefault(const T& new_default) { m_Default = new_default; }
 
+		// Set every element of the allocated pages to value, pages stay allocated
+		void Fill(const T& value) {
+			for (page_type& page : m_Book) {
+				if (page != nullptr) { std::fill_n(page, m_PageSize, value); }
+			}
+		}
+
 		PagedArray() { std::fill(m_Book.begin(), m_Book.end(), nullptr); }
+		~PagedArray() {
+			for (page_type& page : m_Book) {
+				delete[] page;
+			}
+		}
 		PagedArray(const PagedArray& other) = delete;
 		PagedArray(PagedArray&& other) noexcept
 			: m_Book(std::move(other.m_Book)), m_Default(std::move(other.m_Default))
@@ -90,6 +108,11 @@ namespace ECS {
 
 		PagedArray& operator=(const PagedArray& other) = delete;
 		PagedArray& operator=(PagedArray&& other) noexcept {
+			// Free our own pages before taking the other array's
+			for (page_type& page : m_Book) {
+				delete[] page;
+			}
+
 			m_Book = std::move(other.m_Book);
 			m_Default = std::move(other.m_Default);
 
@@ -100,6 +123,13 @@ namespace ECS {
 			return *this;
 		}
 
+		// Address of element if its page is allocated, otherwise nullptr (never allocates)
+		const T* TryGet(const ECS_SIZE_TYPE& index) const {
+			const page_type& page = m_Book[index / m_PageSize];
+
+			return page != nullptr ? &page[index % m_PageSize] : nullptr;
+		}
+
 		T& operator[](const ECS_SIZE_TYPE& index)				{ return m_Index(index); }
 		const T& operator[](const ECS_SIZE_TYPE& index) const	{ return m_Index(index); }
 	};
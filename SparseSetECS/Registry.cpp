@@ -1,8 +1,43 @@
+#include <thread>
+#include <unordered_set>
+
 #include "Registry.h"
 #include "View.h"
 #include "Group.h"
+#include "RuntimeView.h"
 
 namespace ECS {
+	void Registry::m_PartitionPools(const std::vector<ComponentPool*>& pools, const std::vector<Entity>& members)
+	{
+		ECS_TRACE_ZONE("Registry::PartitionPools");
+
+		ECS_SIZE_TYPE count = static_cast<ECS_SIZE_TYPE>(members.size());
+
+		// Not worth starting threads for
+		if (count < ECS_PARALLEL_PARTITION_MIN || pools.size() == 1) {
+			for (ComponentPool* pool : pools) {
+				pool->m_Reorder(members.data(), count);
+			}
+
+			return;
+		}
+
+		std::vector<std::thread> workers;
+		workers.reserve(pools.size() - 1);
+
+		// Each pool only touches its own arrays, so they can be reordered at the same time
+		for (std::size_t i = 1; i < pools.size(); i++) {
+			workers.emplace_back(&ComponentPool::m_Reorder, pools[i], members.data(), count);
+		}
+
+		// Do the first one ourselves
+		pools[0]->m_Reorder(members.data(), count);
+
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
 	void Registry::m_MoveEntityIntoOwningGroup(const Entity& entity, const Signature& owned_pools)
 	{
 		GroupData* relevant_group = nullptr;
@@ -19,6 +54,8 @@ namespace ECS {
 						Entity& replacement_entity = pool->m_PackedArray.data[pool->m_OwningGroup->end_index];
 						// Move this entity to the end of the group
 						pool->Swap(entity, replacement_entity);
+
+						ECS_STAT(++m_Counters.group_swaps);
 					}
 				}
 			}
@@ -29,6 +66,8 @@ namespace ECS {
 
 	void Registry::m_MoveEntityIntoOwningGroupWithUniqueValidation(const Entity& entity, const Signature& signature)
 	{
+		ECS_TRACE_ZONE("Registry::GroupFixup");
+
 		std::vector<std::shared_ptr<GroupData>> relevant_groups;
 
 		bool moved_entity = false;
@@ -40,7 +79,7 @@ namespace ECS {
 					// If this pool is in our group
 					if (pool->m_OwningGroup->ContainsSignature(signature)) {
 						// Ensure this pool doesn't already contain this entity
-						ECS_SIZE_TYPE current_index = pool->m_SparseArray[GetIdentifier(entity)];
+						ECS_SIZE_TYPE current_index = pool->m_SparseGet(entity);
 						// Check current index is within bounds of that pools group
 						// This is not contained within the owning of this pool already
 						// So move it inside
@@ -54,6 +93,8 @@ namespace ECS {
 							// Move this entity to the end of the group
 							pool->Swap(entity, replacement_entity);
 
+							ECS_STAT(++m_Counters.group_swaps);
+
 							moved_entity = true;
 						}
 					}
@@ -69,21 +110,331 @@ namespace ECS {
 		}
 	}
 
+	void Registry::m_MoveEntityOutOfOwningGroups(const Entity& entity, const Signature& signature, const ECS_COMP_ID_TYPE& comp_id)
+	{
+		std::vector<std::shared_ptr<GroupData>> relevant_groups;
+
+		for (ComponentPool* pool : m_Pools) {
+			if (pool != nullptr) {
+				if (pool->m_OwningGroup != nullptr) {
+					// If this group cares about the component and the entity is currently in it
+					if (pool->m_OwningGroup->ContainsID(comp_id) && pool->m_OwningGroup->ContainsSignature(signature)) {
+						ECS_SIZE_TYPE current_index = pool->m_SparseGet(entity);
+
+						if (current_index >= pool->m_OwningGroup->start_index && current_index < pool->m_OwningGroup->end_index) {
+							if (std::find(relevant_groups.begin(), relevant_groups.end(), pool->m_OwningGroup) == relevant_groups.end()) {
+								relevant_groups.push_back(pool->m_OwningGroup);
+							}
+
+							// Swap the last entity in that group with ourselves
+							Entity last_entity = pool->m_PackedArray[pool->m_OwningGroup->end_index - 1];
+							pool->Swap(entity, last_entity);
+
+							ECS_STAT(++m_Counters.group_swaps);
+						}
+					}
+				}
+			}
+		}
+
+		for (std::shared_ptr<GroupData>& group : relevant_groups) {
+			// Decrement size of group because we removed an entity from it
+			--(group->end_index);
+		}
+	}
+
+	void Registry::m_RemoveComponent(const Entity& entity, const ECS_COMP_ID_TYPE& comp_id, bool release_shared)
+	{
+		Signature& signature = m_WriteSignature(entity);
+
+		if (!signature.test(comp_id)) {
+			LogWarn("Entity {} doesn't have component {}, can't remove", entity, comp_id);
+
+			return;
+		}
+
+		// Don't leave relatives pointing at us
+		bool relationship = comp_id == ComponentAllocator<Relationship>::GetID();
+
+		if (relationship) {
+			m_DetachRelationship(entity);
+
+			// We're a lone root now, take our slot out of the middle without pulling the last entity ahead of its parent
+			m_MoveSubtree(entity, m_Pools[comp_id]->GetSize());
+		}
+
+		// Groups have to be fixed up while the entity still has the component
+		m_MoveEntityOutOfOwningGroups(entity, signature, comp_id);
+
+		// Update signature for this entity
+		signature.set(comp_id, false);
+
+		for (ComponentIndexBase* index : m_Indexes[comp_id]) {
+			index->Erase(entity);
+		}
+
+		// Component is a handle into a shared table
+		if (release_shared && m_SharedTables[comp_id] != nullptr) {
+			m_SharedTables[comp_id]->Release(*reinterpret_cast<const SharedHandle_t*>(m_Pools[comp_id]->m_ReadRawForEntity(entity)));
+		}
+
+		m_Pools[comp_id]->FreeEntity(entity);
+
+		m_UpdateNonOwningGroups(entity, signature, comp_id);
+	}
+
+	void Registry::m_UpdateNonOwningGroups(const Entity& entity, const Signature& signature, const ECS_COMP_ID_TYPE& comp_id)
+	{
+		for (std::shared_ptr<GroupData>& group : m_NonOwningGroups) {
+			// Membership can only have changed if the group cares about this component
+			if (!group->ContainsID(comp_id)) continue;
+
+			bool matches = group->ContainsSignature(signature);
+			bool member = group->HasMember(entity);
+
+			if (matches && !member) {
+				group->AddMember(entity);
+			}
+			else if (!matches && member) {
+				group->RemoveMember(entity);
+			}
+		}
+	}
+
+	void Registry::m_UnlinkParent(const Entity& entity)
+	{
+		Relationship* relationship = GetComponent<Relationship>(entity);
+
+		if (relationship->parent == null_entity) return;
+
+		// Point our neighbours at each other
+		if (relationship->prev_sibling != null_entity) {
+			GetComponent<Relationship>(relationship->prev_sibling)->next_sibling = relationship->next_sibling;
+		}
+		else {
+			GetComponent<Relationship>(relationship->parent)->first_child = relationship->next_sibling;
+		}
+
+		if (relationship->next_sibling != null_entity) {
+			GetComponent<Relationship>(relationship->next_sibling)->prev_sibling = relationship->prev_sibling;
+		}
+
+		--(GetComponent<Relationship>(relationship->parent)->children);
+
+		// Our subtree leaves every ancestor's, the last one is the root whose block we sit in
+		ECS_SIZE_TYPE subtree = relationship->descendants + 1;
+		Entity root = null_entity;
+
+		for (Entity ancestor = relationship->parent; ancestor != null_entity; ) {
+			Relationship* ancestor_relationship = GetComponent<Relationship>(ancestor);
+			ancestor_relationship->descendants -= subtree;
+
+			root = ancestor;
+			ancestor = ancestor_relationship->parent;
+		}
+
+		relationship->parent = null_entity;
+		relationship->prev_sibling = null_entity;
+		relationship->next_sibling = null_entity;
+
+		// Move our block to the end of the root's, so the root's and every old ancestor's stay contiguous
+		ComponentPool* pool = m_Pools[ComponentAllocator<Relationship>::GetID()];
+		m_MoveSubtree(entity, pool->m_SparseGet(root) + 1 + GetComponent<const Relationship>(root)->descendants + subtree);
+	}
+
+	void Registry::m_MoveSubtree(const Entity& entity, const ECS_SIZE_TYPE& target)
+	{
+		ComponentPool* pool = m_Pools[ComponentAllocator<Relationship>::GetID()];
+
+		// Groups owning the pool keep their own order, SortHierarchy rebuilds ours once they're gone
+		if (m_HierarchyDirty || pool->HasExistingGroup()) {
+			m_HierarchyDirty = true;
+
+			return;
+		}
+
+		ECS_SIZE_TYPE first = pool->m_SparseGet(entity);
+		ECS_SIZE_TYPE last = first + 1 + GetComponent<const Relationship>(entity)->descendants;
+
+		if (target < first) {
+			pool->m_Rotate(target, first, last);
+		}
+		else if (target > last) {
+			pool->m_Rotate(first, last, target);
+		}
+	}
+
+	void Registry::m_DetachRelationship(const Entity& entity)
+	{
+		m_UnlinkParent(entity);
+
+		Relationship* relationship = GetComponent<Relationship>(entity);
+		Entity child = relationship->first_child;
+
+		// Children become roots, which can be anywhere in the pool
+		while (child != null_entity) {
+			Relationship* child_relationship = GetComponent<Relationship>(child);
+			Entity next_child = child_relationship->next_sibling;
+
+			child_relationship->parent = null_entity;
+			child_relationship->prev_sibling = null_entity;
+			child_relationship->next_sibling = null_entity;
+
+			child = next_child;
+		}
+
+		relationship->first_child = null_entity;
+		relationship->children = 0;
+		relationship->descendants = 0;
+	}
+
+	void Registry::SetParent(const Entity& child, const Entity& parent)
+	{
+		if (child == parent) {
+			LogError("Can't make entity {} its own parent", child);
+
+			return;
+		}
+
+		// Parent can't be somewhere below child
+		if (parent != null_entity && HasComponent<Relationship>(parent)) {
+			for (Entity ancestor = GetComponent<const Relationship>(parent)->parent; ancestor != null_entity; ancestor = GetComponent<const Relationship>(ancestor)->parent) {
+				if (ancestor == child) {
+					LogError("Can't make entity {} the parent of {}, it is one of its descendants", parent, child);
+
+					return;
+				}
+			}
+		}
+
+		// Emplacing can resize the pool, so do it before taking any pointers
+		if (!HasComponent<Relationship>(child)) { EmplaceComponent<Relationship>(child); }
+		if (parent != null_entity && !HasComponent<Relationship>(parent)) { EmplaceComponent<Relationship>(parent); }
+
+		m_UnlinkParent(child);
+
+		if (parent == null_entity) return;
+
+		Relationship* relationship = GetComponent<Relationship>(child);
+		Relationship* parent_relationship = GetComponent<Relationship>(parent);
+
+		// Link in as the first child
+		relationship->parent = parent;
+		relationship->next_sibling = parent_relationship->first_child;
+
+		if (parent_relationship->first_child != null_entity) {
+			GetComponent<Relationship>(parent_relationship->first_child)->prev_sibling = child;
+		}
+
+		parent_relationship->first_child = child;
+		++(parent_relationship->children);
+
+		ECS_SIZE_TYPE subtree = relationship->descendants + 1;
+
+		for (Entity ancestor = parent; ancestor != null_entity; ancestor = GetComponent<const Relationship>(ancestor)->parent) {
+			GetComponent<Relationship>(ancestor)->descendants += subtree;
+		}
+
+		// Child's block goes right behind parent, only the slots between the two shift
+		m_MoveSubtree(child, m_Pools[ComponentAllocator<Relationship>::GetID()]->m_SparseGet(parent) + 1);
+	}
+
+	void Registry::SortHierarchy()
+	{
+		if (!m_HierarchyDirty) return;
+
+		ECS_TRACE_ZONE("Registry::SortHierarchy");
+
+		ComponentPool* pool = m_Pools[ComponentAllocator<Relationship>::GetID()];
+
+		if (pool == nullptr) return;
+
+		if (pool->HasExistingGroup()) {
+			LogError("Can't sort hierarchy, Relationship pool is owned by a group");
+
+			return;
+		}
+
+		std::vector<Entity> order;
+		std::vector<Entity> stack;
+		order.reserve(pool->GetSize());
+
+		// Depth-first from each root, roots stay in the order they are in now
+		for (ECS_SIZE_TYPE index = 0; index < pool->GetSize(); index++) {
+			if (pool->m_Index<Relationship>(index)->parent != null_entity) continue;
+
+			stack.push_back(pool->m_PackedArray[index]);
+
+			while (!stack.empty()) {
+				Entity entity = stack.back();
+				stack.pop_back();
+
+				order.push_back(entity);
+
+				// Push children backwards, so the first child is visited first
+				std::size_t first = stack.size();
+
+				for (Entity child = GetComponent<const Relationship>(entity)->first_child; child != null_entity; child = GetComponent<const Relationship>(child)->next_sibling) {
+					stack.push_back(child);
+				}
+
+				std::reverse(stack.begin() + first, stack.end());
+			}
+		}
+
+		pool->m_Reorder(order.data(), static_cast<ECS_SIZE_TYPE>(order.size()));
+
+		m_HierarchyDirty = false;
+	}
+
 	Registry::Registry(ECS_SIZE_TYPE default_capacity)
 		: m_DefaultCapacity(default_capacity)
 	{
 		// Fill up component pools with nullptrs (leaving them uninitialised)
 		std::fill(m_Pools.begin(), m_Pools.end(), nullptr);
+		std::fill(m_SharedTables.begin(), m_SharedTables.end(), nullptr);
 	}
 
 	Registry::~Registry()
 	{
+		// Forks destroy their copies through the pools' allocators
+		for (RegistryFork* fork : m_Forks) {
+			delete fork;
+		}
+
 		for (ComponentPool* pool : m_Pools) {
 			delete pool;
 		}
+
+		for (SharedTableBase* table : m_SharedTables) {
+			delete table;
+		}
+
+		for (std::vector<ComponentIndexBase*>& indexes : m_Indexes) {
+			for (ComponentIndexBase* index : indexes) {
+				delete index;
+			}
+		}
+	}
+
+	void Registry::DeleteIndex(ComponentIndexBase* index) {
+		for (std::vector<ComponentIndexBase*>& indexes : m_Indexes) {
+			auto it = std::find(indexes.begin(), indexes.end(), index);
+
+			if (it != indexes.end()) {
+				indexes.erase(it);
+				delete index;
+
+				return;
+			}
+		}
+
+		LogWarn("Attempted to delete an index that doesn't belong to this registry");
 	}
 
 	void Registry::Resize(ECS_SIZE_TYPE new_capacity) {
+		ECS_TRACE_ZONE("Registry::Resize");
+
 		// Iterate each component pool
 		for (ComponentPool* pool : m_Pools) {
 			// Ensure component pool is valid, and if so, resize
@@ -93,57 +444,1128 @@ namespace ECS {
 		}
 	}
 	
-	void Registry::FreeEntity(const Entity& entity) {
-		// Free components assosciated with that entity
+	void Registry::ShrinkToFit() {
 		for (ComponentPool* pool : m_Pools) {
-			// If pool is allocated
 			if (pool != nullptr) {
-				// If pool contains us
-				if (pool->Contains(entity)) {
-					// Free ourselves from the pool
-					pool->FreeEntity(entity);
-					// Update our signature
-					m_Signatures[GetIdentifier(entity)].set(pool->m_ID, false);
-				}
+				pool->ShrinkToFit();
 			}
 		}
+	}
 
-		// Now setup entity to be recycled
-		// Increment available entities
-		++m_AvailableEntities;
-		// Get a reference to the now destroyed entity in our entities in use vector
-		Entity& destroyed_entity = m_EntitiesInUse[GetIdentifier(entity)];
-		// Increase version of this destroyed entity
-		AddValueToVersion(destroyed_entity, 1);
-		// Now swap that with whatever is our next entity right now
-		std::swap(destroyed_entity, m_NextEntity);
-		// Now next entity points to where our destroyed entity was, which points to what next was pointing towards
+	void Registry::Flip() {
+		ECS_TRACE_ZONE("Registry::Flip");
+
+		for (ComponentPool* pool : m_Pools) {
+			if (pool != nullptr) {
+				pool->Flip();
+			}
+		}
 	}
-	
-	[[nodiscard]] Entity Registry::Create() {
-		// If we have an entity available for recycling
-		if (m_AvailableEntities > 0) {
-			// Get what the next entity in our list is pointing to
-			Entity& next_next_entity = m_EntitiesInUse[GetIdentifier(m_NextEntity)];
-			// Swap the next entity (the one about to be recycled) and what it points towards
-			std::swap(m_NextEntity, next_next_entity);
-			// Decrement available entities
-			--m_AvailableEntities;
-			// Return our next entity (which is whatever is stored at next_next_entity after the swap)
-			return next_next_entity;
+
+	void Registry::Clear() {
+		ECS_TRACE_ZONE("Registry::Clear");
+
+		// Save what's about to be overwritten into the newest fork
+		if (!m_Forks.empty()) {
+			Identifier_t largest = m_NextLargestEntity.load(std::memory_order_relaxed);
+
+			for (Identifier_t identifier = 0; identifier < largest; identifier += ECS_SPARSE_PAGE) {
+				m_TouchSignaturePage(identifier / ECS_SPARSE_PAGE);
+			}
+
+			for (Identifier_t identifier = 0; identifier < largest; identifier += ECS_PACKED_PAGE) {
+				m_TouchEntitySlot(identifier);
+			}
 		}
-		// Just return a new entity
-		else {
-			if (m_NextLargestEntity > ECS_ENTITY_MAX) {
-				LogError("Ran out of entities, attempt to free entities so they can be recycled");
 
-				return ECS_ENTITY_MAX;
+		for (ComponentPool* pool : m_Pools) {
+			if (pool != nullptr) {
+				pool->m_Clear();
+
+				if (pool->m_OwningGroup != nullptr) { pool->m_OwningGroup->end_index = pool->m_OwningGroup->start_index; }
 			}
+		}
 
-			// Push into entities in use
-			m_EntitiesInUse.push_back(m_NextLargestEntity);
-			// Return entity
-			return m_NextLargestEntity++;
+		for (SharedTableBase* table : m_SharedTables) {
+			if (table != nullptr) { table->Clear(); }
+		}
+
+		for (std::vector<ComponentIndexBase*>& indexes : m_Indexes) {
+			for (ComponentIndexBase* index : indexes) {
+				index->Clear();
+			}
+		}
+
+		for (std::shared_ptr<GroupData>& group : m_NonOwningGroups) {
+			group->ClearMembers();
+		}
+
+		// Pages stay allocated, so this is a memset
+		m_Signatures.Fill(Signature{});
+		m_SpillStore.Clear();
+
+		m_EntitiesInUse.clear();
+		m_NextEntity.store(ECS_ENTITY_MAX, std::memory_order_relaxed);
+		m_NextLargestEntity.store(0, std::memory_order_relaxed);
+		m_AvailableEntities.store(0, std::memory_order_relaxed);
+		m_HierarchyDirty = false;
+	}
+
+	void Registry::m_ClearPool(const ECS_COMP_ID_TYPE& comp_id)
+	{
+		ComponentPool* pool = m_Pools[comp_id];
+
+		if (pool == nullptr) return;
+
+		// Signatures first, while the pool still knows which entities have the component
+		for (ECS_SIZE_TYPE index = 0; index < pool->GetSize(); index++) {
+			const Entity& entity = pool->m_PackedArray[index];
+
+			if (!IsTombstone(entity)) { m_WriteSignature(entity).set(comp_id, false); }
+		}
+
+		// Every member of a group involving the component had it
+		for (ComponentPool* other : m_Pools) {
+			if (other != nullptr && other->m_OwningGroup != nullptr && other->m_OwningGroup->ContainsID(comp_id)) {
+				other->m_OwningGroup->end_index = other->m_OwningGroup->start_index;
+			}
+		}
+
+		for (std::shared_ptr<GroupData>& group : m_NonOwningGroups) {
+			if (group->ContainsID(comp_id)) { group->ClearMembers(); }
+		}
+
+		for (ComponentIndexBase* index : m_Indexes[comp_id]) {
+			index->Clear();
+		}
+
+		// Only this pool holds handles into the table
+		if (m_SharedTables[comp_id] != nullptr) { m_SharedTables[comp_id]->Clear(); }
+
+		// Nobody has a parent or children any more
+		if (comp_id == ComponentAllocator<Relationship>::GetID()) { m_HierarchyDirty = false; }
+
+		pool->m_Clear();
+	}
+
+	void Registry::m_TouchSignaturePage(const ECS_SIZE_TYPE& page)
+	{
+		RegistryFork* fork = m_Forks.back();
+
+		if (m_SignaturePageVersions[page] >= fork->epoch) return;
+
+		std::unique_ptr<Signature[]> saved = std::make_unique<Signature[]>(ECS_SPARSE_PAGE);
+
+		for (ECS_SIZE_TYPE i = 0; i < ECS_SPARSE_PAGE; i++) {
+			// Don't allocate pages just to read them
+			const Signature* signature = m_Signatures.TryGet(page * ECS_SPARSE_PAGE + i);
+
+			if (signature != nullptr) { saved[i] = *signature; }
+		}
+
+		fork->signature_pages.emplace(page, std::move(saved));
+		m_SignaturePageVersions[page] = fork->epoch;
+	}
+
+	void Registry::m_TouchEntitySlot(const Identifier_t& identifier)
+	{
+		if (m_Forks.empty()) return;
+
+		RegistryFork* fork = m_Forks.back();
+		ECS_SIZE_TYPE page = identifier / ECS_PACKED_PAGE;
+		std::atomic_ref<std::uint32_t> version(m_EntityPageVersions[page]);
+
+		if (version.load(std::memory_order_acquire) >= fork->epoch) return;
+
+		// Worker threads reserving entities may race us to the same page
+		std::lock_guard<std::mutex> lock(m_ForkMutex);
+
+		if (version.load(std::memory_order_relaxed) >= fork->epoch) return;
+
+		std::unique_ptr<Entity[]> saved = std::make_unique<Entity[]>(ECS_PACKED_PAGE);
+		std::size_t first = static_cast<std::size_t>(page) * ECS_PACKED_PAGE;
+		std::size_t last = std::min(first + ECS_PACKED_PAGE, m_EntitiesInUse.size());
+
+		for (std::size_t index = first; index < last; index++) {
+			saved[index - first] = std::atomic_ref<Entity>(m_EntitiesInUse[index]).load(std::memory_order_relaxed);
+		}
+
+		fork->entity_pages.emplace(page, std::move(saved));
+		version.store(fork->epoch, std::memory_order_release);
+	}
+
+	void Registry::m_UpdateActiveFork()
+	{
+		RegistryFork* newest = m_Forks.empty() ? nullptr : m_Forks.back();
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			ComponentPool* pool = m_Pools[id];
+
+			if (pool == nullptr) continue;
+
+			pool->m_Fork = newest != nullptr ? newest->pools[id].get() : nullptr;
+			pool->m_ForkEpoch = newest != nullptr ? newest->epoch : 0;
+		}
+	}
+
+	void Registry::m_RebuildNonOwningGroup(GroupData& group)
+	{
+		group.ClearMembers();
+
+		// Members have to be in every pool, so the smallest is enough to look through
+		ComponentPool* smallest_pool = nullptr;
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (!group.affected_components.test(id)) continue;
+
+			ComponentPool* pool = m_Pools[id];
+
+			// Nothing can match
+			if (pool == nullptr) return;
+
+			if (smallest_pool == nullptr || pool->GetSize() < smallest_pool->GetSize()) { smallest_pool = pool; }
+		}
+
+		if (smallest_pool == nullptr) return;
+
+		for (ECS_SIZE_TYPE index = 0; index < smallest_pool->GetSize(); index++) {
+			const Entity& entity = smallest_pool->m_PackedArray[index];
+
+			if (!IsTombstone(entity) && group.ContainsSignature(m_Signatures[GetIdentifier(entity)])) {
+				group.AddMember(entity);
+			}
+		}
+	}
+
+	void Registry::m_RebuildIndexes(const ECS_COMP_ID_TYPE& comp_id)
+	{
+		ComponentPool* pool = m_Pools[comp_id];
+		std::size_t size_in_bytes = pool->m_Allocator->SizeInBytes();
+
+		for (ComponentIndexBase* index : m_Indexes[comp_id]) {
+			index->Clear();
+
+			for (ECS_SIZE_TYPE packed_index = 0; packed_index < pool->GetSize(); packed_index++) {
+				const Entity& entity = pool->m_PackedArray[packed_index];
+
+				if (!IsTombstone(entity)) {
+					index->Update(entity, &pool->m_ComponentArray[packed_index * size_in_bytes]);
+				}
+			}
+		}
+	}
+
+	RegistryFork* Registry::Fork() {
+		ECS_TRACE_ZONE("Registry::Fork");
+
+		// Every identifier handed out so far should have a slot to save
+		FlushReservedEntities();
+
+		RegistryFork* fork = new RegistryFork();
+		fork->epoch = ++m_ForkEpoch;
+		fork->next_entity = m_NextEntity.load(std::memory_order_relaxed);
+		fork->next_largest_entity = m_NextLargestEntity.load(std::memory_order_relaxed);
+		fork->available_entities = m_AvailableEntities.load(std::memory_order_relaxed);
+		fork->entities_in_use = m_EntitiesInUse.size();
+		fork->hierarchy_dirty = m_HierarchyDirty;
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			ComponentPool* pool = m_Pools[id];
+
+			if (pool == nullptr) continue;
+
+			std::unique_ptr<PoolFork> pool_fork = std::make_unique<PoolFork>(pool->m_Allocator);
+			pool_fork->size = pool->m_PackedArray.size;
+			pool_fork->free_list = pool->m_FreeList;
+			pool_fork->tombstones = pool->m_Tombstones;
+
+			if (pool->m_OwningGroup != nullptr) {
+				pool_fork->group = pool->m_OwningGroup.get();
+				pool_fork->group_start = pool->m_OwningGroup->start_index;
+				pool_fork->group_end = pool->m_OwningGroup->end_index;
+			}
+
+			fork->pools[id] = std::move(pool_fork);
+		}
+
+		// Handles in pools point into these, so reference counts and released values have to come back with them
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (m_SharedTables[id] != nullptr) { fork->shared_tables[id].reset(m_SharedTables[id]->Snapshot()); }
+		}
+
+		m_Forks.push_back(fork);
+		m_UpdateActiveFork();
+
+		return fork;
+	}
+
+	bool Registry::Restore(RegistryFork* fork) {
+		ECS_TRACE_ZONE("Registry::Restore");
+
+		auto it = std::find(m_Forks.begin(), m_Forks.end(), fork);
+
+		if (it == m_Forks.end()) {
+			LogError("Attempted to restore a fork that doesn't belong to this registry");
+
+			return false;
+		}
+
+		// Pools can't be put back in an order that a newer group doesn't expect
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			ComponentPool* pool = m_Pools[id];
+
+			if (pool == nullptr || pool->m_OwningGroup == nullptr) continue;
+
+			if (fork->pools[id] == nullptr || fork->pools[id]->group != pool->m_OwningGroup.get()) {
+				LogError("Pool {} is owned by a group created after the fork, delete the group before restoring", id);
+
+				return false;
+			}
+		}
+
+		std::size_t fork_index = static_cast<std::size_t>(it - m_Forks.begin());
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			ComponentPool* pool = m_Pools[id];
+
+			if (pool == nullptr) continue;
+
+			PoolFork* pool_fork = fork->pools[id].get();
+
+			// Pool didn't exist yet, nothing needs saving on the way out
+			if (pool_fork == nullptr) {
+				pool->m_Fork = nullptr;
+				pool->m_Clear();
+
+				continue;
+			}
+
+			std::vector<PoolFork*> pool_forks;
+
+			for (std::size_t index = fork_index; index < m_Forks.size(); index++) {
+				if (m_Forks[index]->pools[id] != nullptr) { pool_forks.push_back(m_Forks[index]->pools[id].get()); }
+			}
+
+			pool->m_RestoreFork(pool_forks, fork->epoch);
+
+			if (pool->m_OwningGroup != nullptr) {
+				pool->m_OwningGroup->start_index = pool_fork->group_start;
+				pool->m_OwningGroup->end_index = pool_fork->group_end;
+			}
+		}
+
+		// Signatures and the entity recycler, oldest saved copy of each page wins
+		std::unordered_map<ECS_SIZE_TYPE, Signature*> signature_pages;
+		std::unordered_map<ECS_SIZE_TYPE, Entity*> entity_pages;
+
+		for (std::size_t index = fork_index; index < m_Forks.size(); index++) {
+			for (auto& [page, saved] : m_Forks[index]->signature_pages) { signature_pages.try_emplace(page, saved.get()); }
+			for (auto& [page, saved] : m_Forks[index]->entity_pages) { entity_pages.try_emplace(page, saved.get()); }
+		}
+
+		for (auto& [page, saved] : signature_pages) {
+			for (ECS_SIZE_TYPE i = 0; i < ECS_SPARSE_PAGE; i++) {
+				m_Signatures[page * ECS_SPARSE_PAGE + i] = saved[i];
+			}
+		}
+
+		m_EntitiesInUse.resize(fork->entities_in_use);
+
+		for (auto& [page, saved] : entity_pages) {
+			std::size_t first = static_cast<std::size_t>(page) * ECS_PACKED_PAGE;
+			std::size_t last = std::min(first + ECS_PACKED_PAGE, m_EntitiesInUse.size());
+
+			for (std::size_t index = first; index < last; index++) {
+				m_EntitiesInUse[index] = saved[index - first];
+			}
+		}
+
+		m_NextEntity.store(fork->next_entity, std::memory_order_relaxed);
+		m_NextLargestEntity.store(fork->next_largest_entity, std::memory_order_relaxed);
+		m_AvailableEntities.store(fork->available_entities, std::memory_order_relaxed);
+		m_HierarchyDirty = fork->hierarchy_dirty;
+
+		// Copy the fork's tables rather than taking them, so it can be restored again
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (m_SharedTables[id] == nullptr) continue;
+
+			delete m_SharedTables[id];
+			m_SharedTables[id] = fork->shared_tables[id] != nullptr ? fork->shared_tables[id]->Snapshot() : nullptr;
+		}
+
+		// Newer forks describe a future that no longer happens
+		for (std::size_t index = fork_index + 1; index < m_Forks.size(); index++) {
+			delete m_Forks[index];
+		}
+
+		m_Forks.resize(fork_index + 1);
+
+		// Only the pages fork has saved are up to date in it now
+		std::fill(m_SignaturePageVersions.begin(), m_SignaturePageVersions.end(), 0);
+		std::fill(m_EntityPageVersions.begin(), m_EntityPageVersions.end(), 0);
+
+		for (auto& [page, saved] : fork->signature_pages) { m_SignaturePageVersions[page] = fork->epoch; }
+		for (auto& [page, saved] : fork->entity_pages) { m_EntityPageVersions[page] = fork->epoch; }
+
+		// Derived state isn't saved, work it out again
+		for (std::shared_ptr<GroupData>& group : m_NonOwningGroups) {
+			m_RebuildNonOwningGroup(*group);
+		}
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (!m_Indexes[id].empty()) { m_RebuildIndexes(id); }
+		}
+
+		return true;
+	}
+
+	void Registry::DiscardFork(RegistryFork* fork) {
+		auto it = std::find(m_Forks.begin(), m_Forks.end(), fork);
+
+		if (it == m_Forks.end()) {
+			LogWarn("Attempted to discard a fork that doesn't belong to this registry");
+
+			return;
+		}
+
+		// The fork before this one still needs whatever it doesn't have a copy of yet
+		if (it != m_Forks.begin()) {
+			RegistryFork* older = *(it - 1);
+
+			for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+				// Pools older doesn't know about get cleared when restoring to it
+				if (fork->pools[id] == nullptr || older->pools[id] == nullptr) continue;
+
+				for (auto& [page, saved] : fork->pools[id]->pages) {
+					older->pools[id]->pages.try_emplace(page, std::move(saved));
+				}
+			}
+
+			for (auto& [page, saved] : fork->signature_pages) { older->signature_pages.try_emplace(page, std::move(saved)); }
+			for (auto& [page, saved] : fork->entity_pages) { older->entity_pages.try_emplace(page, std::move(saved)); }
+		}
+
+		m_Forks.erase(it);
+		delete fork;
+
+		m_UpdateActiveFork();
+	}
+
+	RegistryStats Registry::Stats() const {
+		RegistryStats stats;
+
+		stats.entities_alive = m_NextLargestEntity - m_AvailableEntities;
+		stats.entities_created = m_Counters.entities_created;
+		stats.entities_recycled = m_Counters.entities_recycled;
+		stats.emplace_calls = m_Counters.emplace_calls;
+		stats.group_swaps = m_Counters.group_swaps;
+		stats.signature_pages = m_Signatures.GetResidentPageCount();
+
+		// Signatures and the entity recycler
+		stats.bytes_reserved = stats.signature_pages * m_Signatures.GetPageSizeInBytes() + m_EntitiesInUse.capacity() * sizeof(Entity);
+		stats.bytes_used = m_EntitiesInUse.size() * sizeof(Entity);
+
+		for (const ComponentPool* pool : m_Pools) {
+			if (pool != nullptr) {
+				PoolStats pool_stats = pool->Stats();
+
+				stats.bytes_reserved += pool_stats.bytes_reserved;
+				stats.bytes_used += pool_stats.bytes_used;
+				stats.pools.push_back(pool_stats);
+			}
+		}
+
+		return stats;
+	}
+
+	void Registry::FreeEntity(const Entity& entity) {
+		ECS_TRACE_ZONE("Registry::FreeEntity");
+
+		// Its components are only in the spill file, drop them there (works while forks are held, unlike RestoreEvicted)
+		if (m_SpillStore.Find(entity) != nullptr) { m_DiscardEvicted(entity); }
+
+		// Free components assosciated with that entity (releasing any shared values)
+		for (ComponentPool* pool : m_Pools) {
+			// If pool is allocated
+			if (pool != nullptr) {
+				// If pool contains us
+				if (pool->Contains(entity)) {
+					// Free ourselves from the pool (and any groups), and update our signature
+					m_RemoveComponent(entity, pool->m_ID);
+				}
+			}
+		}
+
+		// Entity may have come from ReserveEntity
+		FlushReservedEntities();
+		m_TouchEntitySlot(GetIdentifier(entity));
+
+		// Now setup entity to be recycled
+		// Get a reference to the now destroyed entity in our entities in use vector
+		Entity& destroyed_entity = m_EntitiesInUse[GetIdentifier(entity)];
+		// Increase version of this destroyed entity
+		IncrementVersion(destroyed_entity);
+		// Now swap that with whatever is our next entity right now
+		destroyed_entity = m_NextEntity.exchange(destroyed_entity, std::memory_order_relaxed);
+		// Now next entity points to where our destroyed entity was, which points to what next was pointing towards
+
+		// Increment available entities (after the list is updated, so reservations never see a half-pushed entity)
+		m_AvailableEntities.fetch_add(1, std::memory_order_release);
+	}
+	
+	std::vector<Entity> Registry::MoveEntitiesTo(Registry& destination, std::span<const Entity> entities) {
+		ECS_TRACE_ZONE("Registry::MoveEntitiesTo");
+
+		// Handle in the destination for each of entities, null_entity for the ones that weren't moved
+		std::vector<Entity> result(entities.size(), null_entity);
+
+		if (&destination == this) {
+			LogError("Attempted to move entities into the registry they are already in");
+
+			return result;
+		}
+
+		// Only live entities can move, and each only once (a second copy would move out of an already moved-from slot)
+		std::vector<Entity> sources;
+		std::vector<std::size_t> positions; // Where each of sources is in entities
+		std::vector<Entity> evicted;
+		std::unordered_set<Identifier_t> seen;
+
+		sources.reserve(entities.size());
+		positions.reserve(entities.size());
+
+		for (std::size_t index = 0; index < entities.size(); index++) {
+			const Entity& entity = entities[index];
+
+			if (!m_IsAlive(entity)) {
+				LogError("Entity {} isn't alive, can't move it", entity);
+
+				continue;
+			}
+
+			if (!seen.insert(GetIdentifier(entity)).second) {
+				LogError("Entity {} was given more than once, only moving it once", entity);
+
+				continue;
+			}
+
+			if (m_SpillStore.Find(entity) != nullptr) { evicted.push_back(entity); }
+
+			sources.push_back(entity);
+			positions.push_back(index);
+		}
+
+		// Evicted entities have none of their components in memory, so bring them back before anything is counted
+		if (!evicted.empty()) {
+			RestoreEvicted(evicted);
+
+			std::size_t kept = 0;
+
+			for (std::size_t index = 0; index < sources.size(); index++) {
+				if (m_SpillStore.Find(sources[index]) != nullptr) {
+					LogError("Entity {} couldn't be restored from the spill file, can't move it", sources[index]);
+
+					continue;
+				}
+
+				sources[kept] = sources[index];
+				positions[kept] = positions[index];
+				++kept;
+			}
+
+			sources.resize(kept);
+			positions.resize(kept);
+		}
+
+		std::vector<Entity> moved_entities;
+
+		moved_entities.reserve(sources.size());
+
+		// Count how many components each pool in the destination is going to receive
+		std::array<ECS_SIZE_TYPE, ECS_MAX_COMPONENTS> counts{};
+
+		for (const Entity& entity : sources) {
+			const Signature& signature = m_Signatures[GetIdentifier(entity)];
+
+			for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+				if (signature.test(id)) { ++counts[id]; }
+			}
+		}
+
+		// Create missing pools and shared tables, and resize each pool once up front
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (counts[id] == 0) continue;
+
+			ComponentPool*& pool = destination.m_Pools[id];
+
+			if (pool == nullptr) {
+				pool = new ComponentPool(m_Pools[id]->m_Allocator->Clone());
+				pool->Resize(destination.m_DefaultCapacity);
+			}
+
+			pool->Resize(pool->GetSize() + counts[id]);
+
+			if (m_SharedTables[id] != nullptr && destination.m_SharedTables[id] == nullptr) {
+				destination.m_SharedTables[id] = m_SharedTables[id]->CloneEmpty();
+			}
+		}
+
+		for (std::size_t index = 0; index < sources.size(); index++) {
+			moved_entities.push_back(destination.Create());
+		}
+
+		// Per pool, the entities having its component sorted by where they are in our pool, so neighbours move together
+		std::vector<std::pair<ECS_SIZE_TYPE, std::size_t>> slots;
+		std::vector<Entity> receivers;
+		std::vector<ECS_SIZE_TYPE> source_indices;
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (counts[id] == 0) continue;
+
+			ComponentPool* source = m_Pools[id];
+			ComponentPool* pool = destination.m_Pools[id];
+
+			slots.clear();
+			receivers.clear();
+			source_indices.clear();
+
+			for (std::size_t index = 0; index < sources.size(); index++) {
+				if (m_Signatures[GetIdentifier(sources[index])].test(id)) { slots.emplace_back(source->m_SparseGet(sources[index]), index); }
+			}
+
+			std::sort(slots.begin(), slots.end());
+
+			for (const auto& [source_index, index] : slots) {
+				source_indices.push_back(source_index);
+				receivers.push_back(moved_entities[index]);
+			}
+
+			ECS_SIZE_TYPE first = pool->GetSize();
+			std::size_t size_in_bytes = pool->m_Allocator->SizeInBytes();
+
+			pool->m_PushMoved(receivers.data(), source, source_indices.data(), counts[id]);
+
+			// Shared handles point into our table, so give the destination its own copy of the value
+			if (m_SharedTables[id] != nullptr) {
+				for (ECS_SIZE_TYPE index = 0; index < counts[id]; index++) {
+					SharedHandle_t* handle = reinterpret_cast<SharedHandle_t*>(&pool->m_ComponentArray[(first + index) * size_in_bytes]);
+
+					*handle = m_SharedTables[id]->CopyInto(*handle, destination.m_SharedTables[id]);
+				}
+			}
+
+			// Relatives are handles into this registry, so entities arrive as roots
+			if (id == ComponentAllocator<Relationship>::GetID()) {
+				for (ECS_SIZE_TYPE index = 0; index < counts[id]; index++) {
+					*reinterpret_cast<Relationship*>(&pool->m_ComponentArray[(first + index) * size_in_bytes]) = Relationship{};
+				}
+			}
+
+			for (ECS_SIZE_TYPE index = 0; index < counts[id] && !destination.m_Indexes[id].empty(); index++) {
+				destination.m_UpdateIndexes(receivers[index], id);
+			}
+		}
+
+		for (std::size_t index = 0; index < sources.size(); index++) {
+			destination.m_WriteSignature(moved_entities[index]) = m_Signatures[GetIdentifier(sources[index])];
+		}
+
+		// Every pool got its new entities as a block behind everything else, so swap the ones that belong in
+		// each owning group in one after another right behind its end, then move the end once
+		std::vector<GroupData*> owning_groups;
+		std::vector<ECS_SIZE_TYPE> joined;
+
+		for (ComponentPool* pool : destination.m_Pools) {
+			if (pool == nullptr || pool->m_OwningGroup == nullptr) continue;
+
+			GroupData* group = pool->m_OwningGroup.get();
+			ECS_SIZE_TYPE count = 0;
+
+			for (const Entity& moved_entity : moved_entities) {
+				if (!group->ContainsSignature(destination.m_Signatures[GetIdentifier(moved_entity)])) continue;
+
+				Entity replacement_entity = pool->m_PackedArray[group->end_index + count];
+
+				pool->Swap(moved_entity, replacement_entity);
+				++count;
+
+				ECS_STAT(++destination.m_Counters.group_swaps);
+			}
+
+			if (std::find(owning_groups.begin(), owning_groups.end(), group) == owning_groups.end()) {
+				owning_groups.push_back(group);
+				joined.push_back(count);
+			}
+		}
+
+		for (std::size_t index = 0; index < owning_groups.size(); index++) {
+			owning_groups[index]->end_index += joined[index];
+		}
+
+		for (std::shared_ptr<GroupData>& group : destination.m_NonOwningGroups) {
+			for (const Entity& moved_entity : moved_entities) {
+				if (group->ContainsSignature(destination.m_Signatures[GetIdentifier(moved_entity)])) { group->AddMember(moved_entity); }
+			}
+		}
+
+		// Deconstructs the moved-from components, and releases our shared values
+		for (std::size_t index = 0; index < sources.size(); index++) {
+			FreeEntity(sources[index]);
+
+			result[positions[index]] = moved_entities[index];
+		}
+
+		return result;
+	}
+
+	void Registry::Instantiate(const Entity& prototype, ECS_SIZE_TYPE count, Entity* out) {
+		ECS_TRACE_ZONE("Registry::Instantiate");
+
+		if (count == 0) return;
+
+		for (ECS_SIZE_TYPE index = 0; index < count; index++) {
+			out[index] = Create();
+		}
+
+		Signature signature = m_Signatures[GetIdentifier(prototype)];
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (!signature.test(id)) continue;
+
+			ComponentPool* pool = m_Pools[id];
+
+			ECS_STAT(m_Counters.emplace_calls += count);
+
+			pool->m_PushCopies(prototype, out, count);
+
+			if (m_SharedTables[id] != nullptr) {
+				m_SharedTables[id]->AddReference(*reinterpret_cast<const SharedHandle_t*>(pool->m_ReadRawForEntity(prototype)), count);
+			}
+
+			// Links are handles to the prototype's relatives
+			if (id == ComponentAllocator<Relationship>::GetID()) {
+				for (ECS_SIZE_TYPE index = 0; index < count; index++) {
+					*reinterpret_cast<Relationship*>(pool->m_GetRawForEntity(out[index])) = Relationship{};
+				}
+			}
+
+			for (ECS_SIZE_TYPE index = 0; index < count && !m_Indexes[id].empty(); index++) {
+				m_UpdateIndexes(out[index], id);
+			}
+		}
+
+		for (ECS_SIZE_TYPE index = 0; index < count; index++) {
+			m_WriteSignature(out[index]) = signature;
+		}
+
+		// Every group the copies belong to, found once rather than once per copy
+		std::vector<GroupData*> owning_groups;
+
+		for (ComponentPool* pool : m_Pools) {
+			if (pool == nullptr || pool->m_OwningGroup == nullptr || !pool->m_OwningGroup->ContainsSignature(signature)) continue;
+
+			GroupData* group = pool->m_OwningGroup.get();
+
+			if (std::find(owning_groups.begin(), owning_groups.end(), group) == owning_groups.end()) { owning_groups.push_back(group); }
+
+			// Copies are outside the group, swap them in one after another right behind its end
+			for (ECS_SIZE_TYPE index = 0; index < count; index++) {
+				Entity replacement_entity = pool->m_PackedArray[group->end_index + index];
+
+				pool->Swap(out[index], replacement_entity);
+
+				ECS_STAT(++m_Counters.group_swaps);
+			}
+		}
+
+		for (GroupData* group : owning_groups) {
+			group->end_index += count;
+		}
+
+		for (std::shared_ptr<GroupData>& group : m_NonOwningGroups) {
+			if (!group->ContainsSignature(signature)) continue;
+
+			for (ECS_SIZE_TYPE index = 0; index < count; index++) {
+				group->AddMember(out[index]);
+			}
+		}
+	}
+
+	RuntimeView Registry::CreateRuntimeView(std::span<const ECS_COMP_ID_TYPE> include, std::span<const ECS_COMP_ID_TYPE> exclude) {
+		return RuntimeView(this, include, exclude);
+	}
+
+	PoolColumns Registry::m_GetColumns(const ComponentPool* pool) const {
+		PoolColumns columns;
+
+		columns.entities = pool->m_PackedArray.data;
+		columns.size = pool->GetSize();
+		columns.tombstones = pool->m_Tombstones;
+		columns.component_size = pool->m_Allocator->SizeInBytes();
+		columns.components = columns.component_size != 0 ? pool->m_ComponentArray.data : nullptr;
+
+		return columns;
+	}
+
+	bool Registry::OpenSpillFile(const std::string& path) {
+		if (m_SpillStore.GetCount() != 0) {
+			LogError("{} entities are still evicted, restore them before opening another spill file", m_SpillStore.GetCount());
+
+			return false;
+		}
+
+		if (!m_SpillStore.Open(path)) {
+			LogError("Couldn't open spill file {}", path);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void Registry::Evict(std::span<const Entity> entities) {
+		ECS_TRACE_ZONE("Registry::Evict");
+
+		if (!m_SpillStore.IsOpen()) {
+			LogError("No spill file open, call OpenSpillFile before evicting");
+
+			return;
+		}
+
+		// Forks don't save the spill file, restoring one would lose track of which entities are where
+		if (!m_Forks.empty()) {
+			LogError("Can't evict entities while forks are held");
+
+			return;
+		}
+
+		// Every record goes into one buffer, and the file in one write
+		std::vector<std::byte> buffer;
+		std::vector<std::pair<Entity, SpillStore::Record>> records;
+
+		std::unordered_set<Identifier_t> seen;
+
+		records.reserve(entities.size());
+
+		for (const Entity& entity : entities) {
+			// Stale handles would evict whoever has the identifier now, under the wrong key
+			if (!m_IsAlive(entity)) {
+				LogError("Entity {} isn't alive, can't evict it", entity);
+
+				continue;
+			}
+
+			if (m_SpillStore.Find(entity) != nullptr || !seen.insert(GetIdentifier(entity)).second) {
+				LogWarn("Entity {} is already evicted", entity);
+
+				continue;
+			}
+
+			Signature signature = m_Signatures[GetIdentifier(entity)];
+			bool trivially_copyable = true;
+
+			for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+				if (signature.test(id) && !m_Pools[id]->m_Allocator->TriviallyCopyable()) { trivially_copyable = false; }
+			}
+
+			if (!trivially_copyable) {
+				LogError("Entity {} has a component that isn't trivially copyable, can't evict it", entity);
+
+				continue;
+			}
+
+			SpillStore::Record record;
+			record.offset = buffer.size();
+			record.signature = signature;
+
+			// As bytes, to_ullong would throw once ECS_MAX_COMPONENTS goes past 64
+			buffer.resize(buffer.size() + SpillStore::header_size);
+			memcpy(buffer.data() + record.offset, &entity, sizeof(Entity));
+			memcpy(buffer.data() + record.offset + sizeof(Entity), &signature, sizeof(Signature));
+
+			for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+				if (!signature.test(id)) continue;
+
+				const std::byte* component = m_Pools[id]->m_ReadRawForEntity(entity);
+
+				buffer.insert(buffer.end(), component, component + m_Pools[id]->m_Allocator->SizeInBytes());
+			}
+
+			record.size = static_cast<std::uint32_t>(buffer.size() - record.offset);
+			records.emplace_back(entity, record);
+		}
+
+		if (records.empty()) return;
+
+		std::uint64_t offset = 0;
+
+		if (!m_SpillStore.Append(buffer.data(), buffer.size(), offset)) {
+			LogError("Couldn't write {} evicted entities to the spill file, they were left in memory", records.size());
+
+			return;
+		}
+
+		// Only take them out of memory once they're safely on disk
+		for (auto& [entity, record] : records) {
+			record.offset += offset;
+
+			// Shared handles keep their reference, the value has to be there when they come back
+			for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+				if (record.signature.test(id)) { m_RemoveComponent(entity, id, false); }
+			}
+
+			m_SpillStore.Insert(entity, record);
+		}
+	}
+
+	void Registry::m_DiscardEvicted(const Entity& entity) {
+		const SpillStore::Record* record = m_SpillStore.Find(entity);
+
+		// Saved shared handles are the only thing the record holds onto outside the file
+		bool shared = false;
+
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (record->signature.test(id) && m_SharedTables[id] != nullptr) { shared = true; }
+		}
+
+		if (shared) {
+			std::vector<std::byte> buffer(record->size);
+
+			if (!m_SpillStore.Read(record->offset, buffer.data(), record->size)) {
+				LogError("Couldn't read evicted entity {} from the spill file, its shared values stay referenced", entity);
+			}
+			else {
+				const std::byte* component = buffer.data() + SpillStore::header_size;
+
+				for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+					if (!record->signature.test(id)) continue;
+
+					if (m_SharedTables[id] != nullptr) {
+						SharedHandle_t handle;
+						memcpy(&handle, component, sizeof(SharedHandle_t));
+
+						m_SharedTables[id]->Release(handle);
+					}
+
+					component += m_Pools[id]->m_Allocator->SizeInBytes();
+				}
+			}
+		}
+
+		m_SpillStore.Erase(entity);
+	}
+
+	void Registry::RestoreEvicted(std::span<const Entity> entities) {
+		ECS_TRACE_ZONE("Registry::RestoreEvicted");
+
+		if (!m_Forks.empty()) {
+			LogError("Can't restore evicted entities while forks are held");
+
+			return;
+		}
+
+		std::vector<std::pair<Entity, SpillStore::Record>> records;
+		std::array<ECS_SIZE_TYPE, ECS_MAX_COMPONENTS> counts{};
+
+		std::unordered_set<Identifier_t> seen;
+
+		records.reserve(entities.size());
+
+		for (const Entity& entity : entities) {
+			if (!m_IsAlive(entity)) {
+				LogError("Entity {} isn't alive, can't restore it", entity);
+
+				continue;
+			}
+
+			const SpillStore::Record* record = m_SpillStore.Find(entity);
+
+			// Restoring a repeat would release its saved shared handles a second time
+			if (record == nullptr || !seen.insert(GetIdentifier(entity)).second) {
+				LogWarn("Entity {} isn't evicted, nothing to restore", entity);
+
+				continue;
+			}
+
+			for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+				if (record->signature.test(id)) { ++counts[id]; }
+			}
+
+			records.emplace_back(entity, *record);
+		}
+
+		// Resize each pool once up front
+		for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+			if (counts[id] != 0) { m_Pools[id]->Resize(m_Pools[id]->GetSize() + counts[id]); }
+		}
+
+		// Read in file order, records evicted together are read together
+		std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) { return a.second.offset < b.second.offset; });
+
+		std::vector<std::byte> buffer;
+
+		for (std::size_t first = 0; first < records.size(); ) {
+			std::size_t last = first + 1;
+
+			while (last < records.size() && records[last].second.offset == records[last - 1].second.offset + records[last - 1].second.size) { ++last; }
+
+			std::uint64_t run_offset = records[first].second.offset;
+			std::size_t run_size = static_cast<std::size_t>(records[last - 1].second.offset + records[last - 1].second.size - run_offset);
+
+			buffer.resize(run_size);
+
+			if (!m_SpillStore.Read(run_offset, buffer.data(), run_size)) {
+				LogError("Couldn't read {} evicted entities from the spill file, they stay evicted", last - first);
+
+				first = last;
+
+				continue;
+			}
+
+			for (std::size_t index = first; index < last; index++) {
+				const auto& [entity, record] = records[index];
+				const std::byte* component = buffer.data() + (record.offset - run_offset) + SpillStore::header_size;
+				// Entity may have been given components while it was evicted
+				Signature previous = m_Signatures[GetIdentifier(entity)];
+
+				for (ECS_COMP_ID_TYPE id = 0; id < ECS_MAX_COMPONENTS; id++) {
+					if (!record.signature.test(id)) continue;
+
+					ComponentPool* pool = m_Pools[id];
+
+					if (pool->Contains(entity)) {
+						LogError("Entity {} was given component {} while evicted, keeping that one over the saved one", entity, id);
+
+						// Saved handle still holds a reference
+						if (m_SharedTables[id] != nullptr) {
+							SharedHandle_t handle;
+							memcpy(&handle, component, sizeof(SharedHandle_t));
+
+							m_SharedTables[id]->Release(handle);
+						}
+
+						component += pool->m_Allocator->SizeInBytes();
+
+						continue;
+					}
+
+					pool->m_PushBytes(entity, component);
+					component += pool->m_Allocator->SizeInBytes();
+
+					// Relatives were detached on eviction
+					if (id == ComponentAllocator<Relationship>::GetID()) {
+						*reinterpret_cast<Relationship*>(pool->m_GetRawForEntity(entity)) = Relationship{};
+					}
+
+					m_UpdateIndexes(entity, id);
+				}
+
+				Signature signature = previous | record.signature;
+
+				m_WriteSignature(entity) = signature;
+				m_MoveEntityIntoOwningGroupWithUniqueValidation(entity, signature);
+
+				for (std::shared_ptr<GroupData>& group : m_NonOwningGroups) {
+					if (group->ContainsSignature(signature) && !group->ContainsSignature(previous)) { group->AddMember(entity); }
+				}
+
+				m_SpillStore.Erase(entity);
+			}
+
+			first = last;
+		}
+	}
+
+	[[nodiscard]] Entity Registry::Create() {
+		// If we have an entity available for recycling
+		if (m_AvailableEntities.load(std::memory_order_relaxed) > 0) {
+			// Get what the next entity in our list is pointing to
+			Entity next_entity = m_NextEntity.load(std::memory_order_relaxed);
+			m_TouchEntitySlot(GetIdentifier(next_entity));
+			Entity& next_next_entity = m_EntitiesInUse[GetIdentifier(next_entity)];
+			// Swap the next entity (the one about to be recycled) and what it points towards
+			m_NextEntity.store(next_next_entity, std::memory_order_relaxed);
+			next_next_entity = next_entity;
+			// Decrement available entities
+			m_AvailableEntities.fetch_sub(1, std::memory_order_relaxed);
+
+			ECS_STAT(++m_Counters.entities_recycled);
+			// Return our next entity (which is whatever is stored at next_next_entity after the swap)
+			return next_next_entity;
+		}
+		// Just return a new entity
+		else {
+			if (m_NextLargestEntity.load(std::memory_order_relaxed) > ECS_ENTITY_MAX) {
+				LogError("Ran out of entities, attempt to free entities so they can be recycled");
+
+				return ECS_ENTITY_MAX;
+			}
+
+			ECS_STAT(++m_Counters.entities_created);
+
+			// Take the next identifier, and push into entities in use
+			Entity entity = m_NextLargestEntity.fetch_add(1, std::memory_order_relaxed);
+			FlushReservedEntities();
+			// Return entity
+			return entity;
+		}
+	}
+
+	[[nodiscard]] Entity Registry::ReserveEntity() {
+		// Claim one of the available entities, if there are any
+		ECS_SIZE_TYPE available = m_AvailableEntities.load(std::memory_order_acquire);
+
+		while (available > 0) {
+			if (m_AvailableEntities.compare_exchange_weak(available, available - 1, std::memory_order_acq_rel)) {
+				// We've claimed a node, now pop it off the recycle list
+				// Nothing is pushed while reserving, so the list can't change under us other than by other pops (no ABA)
+				Entity next_entity = m_NextEntity.load(std::memory_order_acquire);
+
+				while (true) {
+					Entity& slot = m_EntitiesInUse[GetIdentifier(next_entity)];
+					Entity next_next_entity = std::atomic_ref<Entity>(slot).load(std::memory_order_acquire);
+
+					if (m_NextEntity.compare_exchange_weak(next_entity, next_next_entity, std::memory_order_acq_rel)) {
+						// Slot now holds the live entity, like in Create
+						m_TouchEntitySlot(GetIdentifier(next_entity));
+						std::atomic_ref<Entity>(slot).store(next_entity, std::memory_order_release);
+
+						ECS_STAT(std::atomic_ref<std::uint64_t>(m_Counters.entities_recycled).fetch_add(1, std::memory_order_relaxed));
+
+						return next_entity;
+					}
+				}
+			}
+		}
+
+		// Otherwise take a fresh identifier
+		Entity entity = m_NextLargestEntity.fetch_add(1, std::memory_order_relaxed);
+
+		if (entity > ECS_ENTITY_MAX) {
+			m_NextLargestEntity.fetch_sub(1, std::memory_order_relaxed);
+
+			LogError("Ran out of entities, attempt to free entities so they can be recycled");
+
+			return ECS_ENTITY_MAX;
+		}
+
+		ECS_STAT(std::atomic_ref<std::uint64_t>(m_Counters.entities_created).fetch_add(1, std::memory_order_relaxed));
+
+		return entity;
+	}
+
+	void Registry::ReserveEntities(ECS_SIZE_TYPE count, Entity* out) {
+		for (ECS_SIZE_TYPE index = 0; index < count; index++) {
+			out[index] = ReserveEntity();
+		}
+	}
+
+	void Registry::FlushReservedEntities() {
+		Entity next_largest_entity = std::min<Entity>(m_NextLargestEntity.load(std::memory_order_acquire), ECS_ENTITY_MAX + 1);
+
+		// Fresh identifiers handed out by ReserveEntity
+		while (m_EntitiesInUse.size() < next_largest_entity) {
+			m_EntitiesInUse.push_back(static_cast<Entity>(m_EntitiesInUse.size()));
 		}
 	}
 }
@@ -2,27 +2,67 @@
 
 #include "ComponentPool.h"
 #include "GroupData.h"
+#include "SharedComponent.h"
+#include "Relationship.h"
+#include "ComponentIndex.h"
+#include "SpillStore.h"
+#include "ColumnarExport.h"
+
+#include <mutex>
+#include <span>
 
 namespace ECS {
 	template <typename T>
 	class SingleView;
+	template <typename T>
+	class FrontView;
 	template <IsValidOwnershipTag... WrappedTypes>
 	class Group;
 	struct GroupData;
+	template <typename... Components>
+	class StaticRegistry;
+	class RuntimeView;
 
 	class Registry {
 	private:
 		// Use entity identifier as index into this to get its signature
 		PagedArray<Signature, ECS_SPARSE_PAGE, ECS_ENTITY_MAX> m_Signatures;
 		std::array<ComponentPool*, ECS_MAX_COMPONENTS> m_Pools;
+		// Indexed by the component id of Shared<T>, null for components that aren't shared
+		std::array<SharedTableBase*, ECS_MAX_COMPONENTS> m_SharedTables;
+		// Secondary indexes of each component, kept up to date on every tracked change
+		std::array<std::vector<ComponentIndexBase*>, ECS_MAX_COMPONENTS> m_Indexes;
+		// Groups that own no pools, and keep their own set of matching entities
+		std::vector<std::shared_ptr<GroupData>> m_NonOwningGroups;
 		ECS_SIZE_TYPE m_DefaultCapacity = 0; // Default capacity for new component pools
+		bool m_HierarchyDirty = false; // A group owned the Relationship pool, so it may have a child before its parent
 
-		Entity m_NextEntity = ECS_ENTITY_MAX; // Next entity to be recycled
-		Entity m_NextLargestEntity = 0; // The largest value entity we have right now
-		ECS_SIZE_TYPE m_AvailableEntities = 0; // Amount of available entities for recycling
+		// Atomic so worker threads can reserve entities (see ReserveEntity)
+		std::atomic<Entity> m_NextEntity = ECS_ENTITY_MAX; // Next entity to be recycled
+		std::atomic<Entity> m_NextLargestEntity = 0; // The largest value entity we have right now
+		std::atomic<ECS_SIZE_TYPE> m_AvailableEntities = 0; // Amount of available entities for recycling
 		// In this array, a given entity's identifier also represents its position within
+		// Fresh entities from ReserveEntity aren't in here until FlushReservedEntities
 		std::vector<Entity> m_EntitiesInUse; // All entities currently in use (alive/dead)
 
+		// Forks, oldest first, the newest one is where pages get saved before they're written to
+		std::vector<RegistryFork*> m_Forks;
+		std::uint32_t m_ForkEpoch = 0; // Epoch of the last fork taken
+		std::array<std::uint32_t, (ECS_ENTITY_MAX + 1) / ECS_SPARSE_PAGE> m_SignaturePageVersions{};
+		std::array<std::uint32_t, (ECS_ENTITY_MAX + 1) / ECS_PACKED_PAGE> m_EntityPageVersions{};
+		std::mutex m_ForkMutex; // Only taken by ReserveEntity, when it has to save a page for the newest fork
+
+		// Where evicted entities' components are, see Evict
+		SpillStore m_SpillStore;
+
+		// Only incremented when ECS_ENABLE_STATS is set
+		struct {
+			std::uint64_t entities_created = 0;
+			std::uint64_t entities_recycled = 0;
+			std::uint64_t emplace_calls = 0;
+			std::uint64_t group_swaps = 0;
+		} m_Counters;
+
 		// TODO: should just be using some lambda fold expression
 		struct __PoolSizeComparator {
 			bool operator()(ComponentPool* a, ComponentPool* b) {
@@ -33,6 +73,89 @@ namespace ECS {
 		void m_MoveEntityIntoOwningGroup(const Entity& entity, const Signature& signature);
 		// This doesn't have validation to ensure an entity isn't moved into the same group twice
 		void m_MoveEntityIntoOwningGroupWithUniqueValidation(const Entity& entity, const Signature& signature);
+		// Move entity out of every owning group that stops matching once it loses this component
+		void m_MoveEntityOutOfOwningGroups(const Entity& entity, const Signature& signature, const ECS_COMP_ID_TYPE& comp_id);
+		// Shared handles release their reference, unless release_shared is false (evicted entities keep theirs)
+		void m_RemoveComponent(const Entity& entity, const ECS_COMP_ID_TYPE& comp_id, bool release_shared = true);
+		// Add entity to or remove entity from non-owning groups involving this component, after its signature changed
+		void m_UpdateNonOwningGroups(const Entity& entity, const Signature& signature, const ECS_COMP_ID_TYPE& comp_id);
+		// Component of entity was added or may have changed, so re-key it in every index of that component
+		inline void m_UpdateIndexes(const Entity& entity, const ECS_COMP_ID_TYPE& comp_id) {
+			if (m_Indexes[comp_id].empty()) return;
+
+			const std::byte* component = m_Pools[comp_id]->m_ReadRawForEntity(entity);
+
+			for (ComponentIndexBase* index : m_Indexes[comp_id]) {
+				index->Update(entity, component);
+			}
+		}
+
+		// Handle is the current version of a live entity (fresh ones from ReserveEntity count, flushed or not)
+		inline bool m_IsAlive(const Entity& entity) const {
+			Identifier_t identifier = GetIdentifier(entity);
+
+			if (identifier < m_EntitiesInUse.size()) return m_EntitiesInUse[identifier] == entity;
+
+			// Not flushed yet, so still on its first version
+			return entity < m_NextLargestEntity.load(std::memory_order_relaxed);
+		}
+
+		// Signature of entity, for writing to, saving its page into the newest fork first
+		inline Signature& m_WriteSignature(const Entity& entity) {
+			Identifier_t identifier = GetIdentifier(entity);
+
+			if (!m_Forks.empty()) { m_TouchSignaturePage(identifier / ECS_SPARSE_PAGE); }
+
+			return m_Signatures[identifier];
+		}
+
+		void m_TouchSignaturePage(const ECS_SIZE_TYPE& page);
+		// Save the page of m_EntitiesInUse holding identifier into the newest fork, before it's written to (safe from ReserveEntity)
+		void m_TouchEntitySlot(const Identifier_t& identifier);
+		// Point every pool at the newest fork (or nothing)
+		void m_UpdateActiveFork();
+		// Recreate derived state that forks don't save
+		void m_RebuildNonOwningGroup(GroupData& group);
+		void m_RebuildIndexes(const ECS_COMP_ID_TYPE& comp_id);
+
+		// Arrays of pool as they are right now, for exporting
+		PoolColumns m_GetColumns(const ComponentPool* pool) const;
+
+		// Take the component away from every entity that has it, the pool keeps its memory
+		void m_ClearPool(const ECS_COMP_ID_TYPE& comp_id);
+
+		// Forget the spill record of an evicted entity that's being freed, releasing the shared values it saved
+		void m_DiscardEvicted(const Entity& entity);
+
+		// Take entity out of its parent's list of children
+		void m_UnlinkParent(const Entity& entity);
+		// Unlink from parent, and make every child a root
+		void m_DetachRelationship(const Entity& entity);
+		// Rotate entity's subtree, a contiguous block of the Relationship pool, in front of the slot at target
+		void m_MoveSubtree(const Entity& entity, const ECS_SIZE_TYPE& target);
+
+		// Start tracking index, filled with every entity that already has T
+		template <typename T, typename Index> Index* m_AddIndex(Index* index) {
+			ECS_COMP_ID_TYPE comp_id = ComponentAllocator<T>::GetID();
+			ComponentPool* pool = m_Pools[comp_id];
+
+			if (pool != nullptr) {
+				for (ECS_SIZE_TYPE packed_index = 0; packed_index < pool->GetSize(); packed_index++) {
+					const Entity& entity = pool->m_PackedArray[packed_index];
+
+					if (!IsTombstone(entity)) {
+						index->Update(entity, reinterpret_cast<std::byte*>(pool->m_Index<T>(packed_index)));
+					}
+				}
+			}
+
+			m_Indexes[comp_id].push_back(index);
+
+			return index;
+		}
+
+		// Move members to the front of each pool in one pass, pools are independent so large groups do them in parallel
+		void m_PartitionPools(const std::vector<ComponentPool*>& pools, const std::vector<Entity>& members);
 
 	public:
 		Registry(ECS_SIZE_TYPE default_capacity = 1000);
@@ -40,6 +163,25 @@ namespace ECS {
 
 		// Resize entire registry (all active component pools)
 		void Resize(ECS_SIZE_TYPE new_capacity);
+
+		// Give back memory pools aren't using (only pools using virtual memory can)
+		void ShrinkToFit();
+
+		// End of frame for double-buffered components, front views made from now on see what was written since the last flip
+		// Safe while other threads read front views, they keep the frame they were made at (see ComponentPool::Flip)
+		void Flip();
+
+		// Destroy every entity and component, keeping all memory (pool capacity, sparse and signature pages) for the next use
+		// Entities are handed out again from the first identifier and version, so handles from before the clear mustn't be used
+		// Groups and indexes stay, and are empty
+		void Clear();
+
+		// Remove T from every entity, keeping the memory of T's pool
+		template <typename T> void Clear() {
+			ECS_TRACE_ZONE("Registry::ClearPool");
+
+			m_ClearPool(ComponentAllocator<T>::GetID());
+		}
 		
 		// Resize specific component pool 
 		template <typename T> void ResizePool(ECS_SIZE_TYPE new_capacity) {
@@ -57,12 +199,165 @@ namespace ECS {
 			pool->Resize(new_capacity);
 		}
 
+		// Remove tombstones from a pool using in-place deletion, invalidates pointers into that pool
+		template <typename T> void CompactPool() {
+			ComponentPool* pool = m_Pools[ComponentAllocator<T>::GetID()];
+
+			if (pool == nullptr) {
+				LogError("Component pool not registered; register pool before attempting compact");
+
+				return;
+			}
+
+			if (pool->HasExistingGroup()) {
+				LogError("Can't compact pool of {}, it is owned by a group", typeid(T).name());
+
+				return;
+			}
+
+			pool->Compact();
+		}
+
 		// Free up an entity id and all associated components
 		void FreeEntity(const Entity& entity);
 
+		// Sizes and counters for the registry and every registered pool
+		RegistryStats Stats() const;
+
 		// Get a new entity to use
 		[[nodiscard]] Entity Create();
 
+		// Thread-safe (lock-free) alternative to Create, for worker threads
+		// Can run concurrently with other reservations, but not with Create, FreeEntity or anything else modifying the registry
+		[[nodiscard]] Entity ReserveEntity();
+		void ReserveEntities(ECS_SIZE_TYPE count, Entity* out);
+
+		// Finish bookkeeping for reserved entities, call on the main thread once workers are done
+		void FlushReservedEntities();
+
+		// Take a copy-on-write snapshot of every pool, signature and entity, which Restore can roll back to
+		// Nothing is copied now, each page of ECS_PACKED_PAGE components is copied on its first write after the fork
+		// Iterating a view or group counts as writing to every page it covers, unless it hands out its components as const
+		// Shared value tables are copied when the fork is taken (not the values themselves), statistics counters aren't part of forks
+		RegistryFork* Fork();
+		// Put the registry back to how it was when fork was taken, costs one page copy per page written since
+		// Forks taken after this one are discarded, this one can be restored again later
+		// Fails if a group that owns pools was created since the fork
+		bool Restore(RegistryFork* fork);
+		// Free a fork, its pages are handed to the fork before it if they are still needed
+		void DiscardFork(RegistryFork* fork);
+
+		// Move entities and all their components into another registry, returns their handles in that registry
+		// Evicted entities are restored first, dead, stale and repeated handles are skipped (null_entity in the result)
+		std::vector<Entity> MoveEntitiesTo(Registry& destination, std::span<const Entity> entities);
+
+		// Create count copies of prototype, with a copy of each of its components, written to out
+		// Each pool grows once and gets the copies side by side, and every group is updated once for all of them
+		// Copies are roots of their own hierarchy (no Relationship links are copied), shared values get a reference per copy
+		void Instantiate(const Entity& prototype, ECS_SIZE_TYPE count, Entity* out);
+
+		// Describe T's pool to Arrow's C data interface without copying it (see ExportColumns), returns T's layout epoch
+		// Stays valid while GetLayoutEpoch<T>() returns the same, until entities get T, lose it, are reordered or the pool grows
+		// Writes to components show up in the export, read it between frames (or from a double-buffered T's front view instead)
+		template <typename T> std::uint64_t ExportPool(ArrowSchema* schema, ArrowArray* array) {
+			ComponentPool* pool = m_Pools[ComponentAllocator<T>::GetID()];
+
+			if (pool == nullptr) {
+				LogError("Component pool not registered; register pool before attempting export");
+
+				// Arrow's marker for released structures, so consumers calling release don't jump through garbage
+				schema->release = nullptr;
+				array->release = nullptr;
+
+				return 0;
+			}
+
+			ExportColumns(m_GetColumns(pool), typeid(T).name(), schema, array);
+
+			return pool->m_LayoutEpoch;
+		}
+
+		// Write T's pool to a file (see WriteColumns)
+		template <typename T> bool WritePoolColumns(const std::string& path) {
+			ComponentPool* pool = m_Pools[ComponentAllocator<T>::GetID()];
+
+			if (pool == nullptr) {
+				LogError("Component pool not registered; register pool before attempting export");
+
+				return false;
+			}
+
+			if (!WriteColumns(m_GetColumns(pool), path)) {
+				LogError("Couldn't write pool of {} to {}", typeid(T).name(), path);
+
+				return false;
+			}
+
+			return true;
+		}
+
+		template <typename T> std::uint64_t GetLayoutEpoch() const {
+			const ComponentPool* pool = m_Pools[ComponentAllocator<T>::GetID()];
+
+			return pool != nullptr ? pool->m_LayoutEpoch : 0;
+		}
+
+		// Open the file evicted entities are written to, it's created or truncated
+		bool OpenSpillFile(const std::string& path);
+		// Write every component of entities to the spill file, then remove them from memory
+		// Entities stay alive with no components until RestoreEvicted, their handles stay valid (FreeEntity drops what was saved)
+		// Only works with trivially copyable components (they're saved as bytes), and not while forks are held
+		// Relationships are detached (they come back as roots), shared values stay referenced
+		void Evict(std::span<const Entity> entities);
+		// Read evicted entities back from the spill file, with every component they had
+		// Components added while evicted are kept, saved ones of the same type are dropped (with an error)
+		void RestoreEvicted(std::span<const Entity> entities);
+		bool IsEvicted(const Entity& entity) const { return m_SpillStore.Find(entity) != nullptr; }
+
+		// Make child the first child of parent (null_entity makes it a root), adds Relationship components where missing
+		// Moves child's subtree right behind parent in the Relationship pool, so pointers to Relationship components are invalidated
+		void SetParent(const Entity& child, const Entity& parent);
+
+		// The Relationship pool is kept depth first as the hierarchy changes, except while a group owns it
+		// This rebuilds the order once the group is gone, reordering the whole pool
+		void SortHierarchy();
+
+		// Call func(entity, relationship) for every entity with a Relationship, parents before their children
+		// A single linear sweep of the pool, so transforms can be propagated in one pass (a SingleView<const Relationship> is the same order)
+		template <typename Func> void ForEachInHierarchy(Func&& func) {
+			ECS_TRACE_ZONE("Registry::ForEachInHierarchy");
+
+			SortHierarchy();
+
+			ComponentPool* pool = m_Pools[ComponentAllocator<Relationship>::GetID()];
+
+			if (pool == nullptr) return;
+
+			// Links only change through SetParent, so they're handed out const and nothing is touched
+			for (ECS_SIZE_TYPE index = 0; index < pool->GetSize(); index++) {
+				func(pool->m_PackedArray[index], *static_cast<const Relationship*>(pool->m_Index<Relationship>(index)));
+			}
+		}
+
+		// Index entities by key_fn(component), for O(1) lookups of entities with a given key
+		// Kept up to date by Emplace/Add/Replace/ApplyToComponent, RemoveComponent and FreeEntity
+		// Changes made through GetComponent pointers aren't seen, use ReplaceComponent or ApplyToComponent for indexed fields
+		template <typename T, typename KeyFn> auto* CreateIndex(KeyFn&& key_fn) {
+			using Key = std::decay_t<std::invoke_result_t<KeyFn, const T&>>;
+
+			return m_AddIndex<T>(new HashIndex<T, Key>(std::forward<KeyFn>(key_fn)));
+		}
+
+		// Same as CreateIndex, but sorted by key for O(log n) lookups and range queries
+		template <typename T, typename KeyFn> auto* CreateOrderedIndex(KeyFn&& key_fn) {
+			using Key = std::decay_t<std::invoke_result_t<KeyFn, const T&>>;
+
+			return m_AddIndex<T>(new OrderedIndex<T, Key>(std::forward<KeyFn>(key_fn)));
+		}
+
+		// Stop maintaining and free an index made by CreateIndex/CreateOrderedIndex
+		void DeleteIndex(ComponentIndexBase* index);
+
 		// Register a component for future use
 		template <typename T> void RegisterComponent() {
 			ECS_SIZE_TYPE id = ComponentAllocator<T>::GetID();
@@ -98,19 +393,25 @@ namespace ECS {
 			T* component = pool->GetComponentForEntity<T>(entity);
 			// Call function on component
 			func(component);
+
+			m_UpdateIndexes(entity, comp_id);
 		}
 
 		template <typename T, typename... Args> void EmplaceComponent(const Entity& entity, Args&&... args) {
 			ECS_SIZE_TYPE comp_id = ComponentAllocator<T>::GetID();
 			ComponentPool* pool = m_Pools[comp_id];
 
-			if (pool == nullptr) { RegisterComponent<T>(); }
+			if (pool == nullptr) { RegisterComponent<T>(); pool = m_Pools[comp_id]; }
+
+			ECS_STAT(++m_Counters.emplace_calls);
 
 			// Emplace this component at the end of the group
 			pool->Emplace<T>(entity, std::forward<Args>(args)...);
 
+			m_UpdateIndexes(entity, comp_id);
+
 			// Update signature for this entity
-			Signature& signature = m_Signatures[GetIdentifier(entity)];
+			Signature& signature = m_WriteSignature(entity);
 			signature.set(comp_id, true);
 
 			// TODO: could speed up by inserting entity into correct location,
@@ -118,6 +419,7 @@ namespace ECS {
 			
 			// We have to update all groups actually
 			m_MoveEntityIntoOwningGroupWithUniqueValidation(entity, signature);
+			m_UpdateNonOwningGroups(entity, signature, comp_id);
 		}
 
 		// Add a new component to an entity
@@ -130,11 +432,15 @@ namespace ECS {
 			// Get pool
 			ComponentPool*& pool = m_Pools[comp_id];
 
+			ECS_STAT(++m_Counters.emplace_calls);
+
 			// Push component into pool
 			pool->Push<T>(entity, std::forward<T>(comp));
 
+			m_UpdateIndexes(entity, comp_id);
+
 			// Update signature for this entity
-			Signature& signature = m_Signatures[GetIdentifier(entity)];
+			Signature& signature = m_WriteSignature(entity);
 			signature.set(comp_id, true);
 
 			// TODO: could speed up by inserting entity into correct location,
@@ -146,6 +452,8 @@ namespace ECS {
 					m_MoveEntityIntoOwningGroupWithUniqueValidation(entity, signature);
 				}
 			}
+
+			m_UpdateNonOwningGroups(entity, signature, comp_id);
 		}
 
 		// Update the value of an already existing component
@@ -164,6 +472,8 @@ namespace ECS {
 			// Component exists
 			if (signature.test(comp_id)) {
 				pool->Replace<T>(entity, std::forward<T>(comp));
+
+				m_UpdateIndexes(entity, comp_id);
 			}
 			else {
 				LogError("Attempted to replace component {} for entity {}, but entity didn't have component", typeid(T).name(), entity);
@@ -172,6 +482,8 @@ namespace ECS {
 
 		// Remove component from an entity
 		template <typename T> void RemoveComponent(const Entity& entity) {
+			ECS_TRACE_ZONE("Registry::RemoveComponent");
+
 			ECS_SIZE_TYPE comp_id = ComponentAllocator<T>::GetID();
 
 			// Pool not registered
@@ -181,51 +493,103 @@ namespace ECS {
 				return;
 			}
 
-			// Update signature for this entity
-			Signature& signature = m_Signatures[GetIdentifier(entity)];
-			signature.set(comp_id, false);
+			m_RemoveComponent(entity, comp_id);
+		}
 
-			GroupData* relevant_group = nullptr;
+		// Get a pointer to a component for an entity
+		// GetComponent<const T> is for reading, it doesn't make forks save the page or double-buffered pools mark it dirty
+		template <typename T> T* GetComponent(const Entity& entity) {
+			// TODO: assert pool not nullptr
+			// TODO: assert entity owns this component
+			using Component = std::remove_const_t<T>;
 
-			// Check if any pool owns this entity
-			for (ComponentPool* pool : m_Pools) {
-				if (pool != nullptr) {
-					// This is our component pool, so we need to just delete it
-					if (pool->m_ID == comp_id) {
-						pool->FreeEntity(entity);
-					}
-					else if (pool->m_OwningGroup != nullptr) {
-						if (pool->m_OwningGroup->OwnsSignature(signature)) {
-							relevant_group = pool->m_OwningGroup;
-
-							// This pool owns us, moves ourselves out of the group
-							// We are going to swap the last entity in that group with ourselves
-							Entity& last_entity = pool->m_PackedArray[pool->m_OwningGroup->end_index];
-							// Perform the swap
-							pool->Swap(entity, last_entity);
-						}
-					}
-				}
+			ComponentPool* pool = m_Pools[ComponentAllocator<Component>::GetID()];
+
+			if constexpr (std::is_const_v<T>) return std::as_const(*pool).GetComponentForEntity<Component>(entity);
+			else return pool->GetComponentForEntity<T>(entity);
+		}
+
+		// Assign a deduplicated value to an entity, entities with equal values share one copy
+		template <IsShareable T, typename... Args> void EmplaceShared(const Entity& entity, Args&&... args) {
+			ECS_COMP_ID_TYPE handle_id = ComponentAllocator<Shared<T>>::GetID();
+
+			// Create table for this type if it doesn't exist yet
+			if (m_SharedTables[handle_id] == nullptr) {
+				m_SharedTables[handle_id] = new SharedTable<T>(handle_id);
 			}
 
-			if (relevant_group != nullptr) {
-				--(relevant_group->end_index);
+			SharedTable<T>* table = static_cast<SharedTable<T>*>(m_SharedTables[handle_id]);
+			SharedHandle_t handle = table->Acquire(T(std::forward<Args>(args)...));
+
+			// Entity already had a shared value, so just point it at the new one
+			if (HasComponent<Shared<T>>(entity)) {
+				Shared<T>* shared = GetComponent<Shared<T>>(entity);
+
+				table->Release(shared->handle);
+				shared->handle = handle;
+			}
+			else {
+				EmplaceComponent<Shared<T>>(entity, handle);
 			}
 		}
 
-		// Get a pointer to a component for an entity
-		template <typename T> T* GetComponent(const Entity& entity) {
-			// TODO: assert pool not nullptr
-			// TODO: assert entity owns this component
-			ComponentPool*& pool = m_Pools[ComponentAllocator<T>::GetID()];
+		// Get the shared value of an entity, values can't be modified since other entities may use them
+		template <IsShareable T> const T* GetShared(const Entity& entity) {
+			ECS_COMP_ID_TYPE handle_id = ComponentAllocator<Shared<T>>::GetID();
+
+			if (m_SharedTables[handle_id] == nullptr || !HasComponent<Shared<T>>(entity)) {
+				LogError("Entity {} doesn't have shared component {}", entity, typeid(T).name());
+
+				return nullptr;
+			}
+
+			SharedTable<T>* table = static_cast<SharedTable<T>*>(m_SharedTables[handle_id]);
 
-			return pool->GetComponentForEntity<T>(entity);
+			return table->GetValue(GetComponent<const Shared<T>>(entity)->handle);
+		}
+
+		template <IsShareable T> void RemoveShared(const Entity& entity) {
+			ECS_COMP_ID_TYPE handle_id = ComponentAllocator<Shared<T>>::GetID();
+
+			if (m_SharedTables[handle_id] == nullptr || !HasComponent<Shared<T>>(entity)) {
+				LogWarn("Entity {} doesn't have shared component {}, can't remove", entity, typeid(T).name());
+
+				return;
+			}
+
+			// Releases the value too
+			RemoveComponent<Shared<T>>(entity);
+		}
+
+		// Call func once for every distinct value of T, with all the entities that share that value
+		template <IsShareable T, typename Func> void ForEachShared(Func&& func) {
+			ECS_TRACE_ZONE("Registry::ForEachShared");
+
+			ECS_COMP_ID_TYPE handle_id = ComponentAllocator<Shared<T>>::GetID();
+
+			if (m_SharedTables[handle_id] == nullptr) return;
+
+			SharedTable<T>* table = static_cast<SharedTable<T>*>(m_SharedTables[handle_id]);
+			ComponentPool* pool = m_Pools[handle_id];
+
+			// Bucket entities by the handle they point to
+			std::vector<std::vector<Entity>> buckets(table->GetCapacity());
+
+			for (ECS_SIZE_TYPE index = 0; index < pool->GetSize(); index++) {
+				buckets[pool->m_Index<Shared<T>>(index)->handle].push_back(pool->m_PackedArray[index]);
+			}
+
+			for (SharedHandle_t handle = 0; handle < buckets.size(); handle++) {
+				if (!buckets[handle].empty()) {
+					func(*table->GetValue(handle), buckets[handle]);
+				}
+			}
 		}
 
 		template <typename T>
 		bool HasComponent(const Entity& entity) {
 			// TODO: ensure this doesn't allocate a new array
-			return m_Signatures[GetIdentifier(entity)].test(ComponentAllocator<T>::GetID());
+			return m_Signatures[GetIdentifier(entity)].test(ComponentAllocator<std::remove_const_t<T>>::GetID());
 		}
 
 		template <typename... Ts>
@@ -247,21 +611,51 @@ namespace ECS {
 		friend class SingleView;
 		template <IsValidOwnershipTag... Ts>
 		friend class Group;
+		template <typename... Components>
+		friend class StaticRegistry;
+		friend class RuntimeView;
 
+		// CreateSingleView<const T> for iterating without writing
 		template <typename T>
 		SingleView<T> CreateSingleView() {
+			using Component = std::remove_const_t<T>;
+
+			if (m_Pools[ComponentAllocator<Component>::GetID()] == nullptr) {
+				LogFatal("Can't create view, object type {} is not registered!", typeid(Component).name());
+			}
+
+			return SingleView<T>(m_Pools[ComponentAllocator<Component>::GetID()]);
+		}
+
+		// Read-only view of T as of the last Flip, safe to make and iterate from other threads while T is written to and flipped
+		template <typename T>
+		FrontView<T> CreateFrontView() {
+			static_assert(ComponentTraits<T>::double_buffered, "Front views need ComponentTraits<T>::double_buffered");
+
 			if (m_Pools[ComponentAllocator<T>::GetID()] == nullptr) {
 				LogFatal("Can't create view, object type {} is not registered!", typeid(T).name());
 			}
 
-			return SingleView<T>(m_Pools[ComponentAllocator<T>::GetID()]);
+			return FrontView<T>(m_Pools[ComponentAllocator<T>::GetID()]);
 		}
 
+		// View of entities with every component in include and none in exclude, chosen at runtime by component id (see RuntimeView)
+		RuntimeView CreateRuntimeView(std::span<const ECS_COMP_ID_TYPE> include, std::span<const ECS_COMP_ID_TYPE> exclude = {});
+
 		template <IsValidOwnershipTag... WrappedTypes>
 		[[nodiscard]] Group<WrappedTypes...> CreateGroup() {
+			ECS_TRACE_ZONE("Registry::CreateGroup");
+
 			std::shared_ptr<GroupData> new_group = std::make_shared<GroupData>();
 			new_group->Init<WrappedTypes...>();
 
+			// Register any pools that don't exist yet
+			([&] {
+				if (m_Pools[ComponentAllocator<typename WrappedTypes::component>::GetID()] == nullptr) {
+					RegisterComponent<typename WrappedTypes::component>();
+				}
+			} (), ...);
+
 			// Get smallest owning component pool
 			ComponentPool* smallest_pool = nullptr;
 			ECS_SIZE_TYPE smallest_size = std::numeric_limits<ECS_SIZE_TYPE>::max();
@@ -273,7 +667,7 @@ namespace ECS {
 				if constexpr (IsOwnedTag<WrappedTypes>) {
 					owned_group = true;
 
-					ECS_COMP_ID_TYPE id = ComponentAllocator<typename WrappedTypes::type>::GetID();
+					ECS_COMP_ID_TYPE id = ComponentAllocator<typename WrappedTypes::component>::GetID();
 					ComponentPool* pool = m_Pools[id];
 					ECS_SIZE_TYPE size = 0;
 
@@ -289,8 +683,15 @@ namespace ECS {
 					if (pool->HasExistingGroup()) {
 						LogFatal("Couldn't construct group, since one affected pool already owned by group");
 					}
+					// Owning groups reorder their pools, which would break pointer stability
+					else if (pool->m_InPlaceDelete) {
+						LogFatal("Couldn't construct group, {} uses in-place deletion so can't be owned", typeid(typename WrappedTypes::component).name());
+					}
 					else {
 						pool->m_OwningGroup = new_group;
+
+						// Partitioning for the group breaks the depth first order, SortHierarchy rebuilds it once the group is gone
+						if constexpr (std::is_same_v<typename WrappedTypes::component, Relationship>) { m_HierarchyDirty = true; }
 					}
 				}
 			} (), ...);
@@ -298,7 +699,7 @@ namespace ECS {
 			// For completely non-owning groups
 			if (!owned_group) {
 				([&] {
-					ECS_COMP_ID_TYPE id = ComponentAllocator<typename WrappedTypes::type>::GetID();
+					ECS_COMP_ID_TYPE id = ComponentAllocator<typename WrappedTypes::component>::GetID();
 					ComponentPool* pool = m_Pools[id];
 					ECS_SIZE_TYPE size = 0;
 
@@ -312,21 +713,44 @@ namespace ECS {
 					}
 				} (), ...);
 
-				new_group->end_index = smallest_size;
+				// Membership is kept up to date by the registry from now on
+				m_NonOwningGroups.push_back(new_group);
 			}
 
-			// Iterate the smallest pool, and move all relevant entities into the group
+			// Work out every entity in the group first, in the order of the smallest pool
+			std::vector<Entity> members;
+			members.reserve(smallest_size);
+
 			for (ECS_SIZE_TYPE pool_index = 0; pool_index < smallest_size; pool_index++) {
 				// Get entity at this index
 				Entity& entity = smallest_pool->m_PackedArray[pool_index];
 
-				// Get signature of entity
-				Signature& signature = m_Signatures[GetIdentifier(entity)];
+				if (IsTombstone(entity)) continue;
 
-				// If this entity matches all our owned types
-				if (new_group->OwnsSignature(signature)) {
-					// Move this entity into the group
-					m_MoveEntityIntoOwningGroupWithUniqueValidation(entity, signature);
+				// If this entity has all our types
+				if (new_group->ContainsSignature(m_Signatures[GetIdentifier(entity)])) {
+					members.push_back(entity);
+				}
+			}
+
+			if (owned_group) {
+				std::vector<ComponentPool*> owned_pools;
+
+				([&] {
+					if constexpr (IsOwnedTag<WrappedTypes>) {
+						owned_pools.push_back(m_Pools[ComponentAllocator<typename WrappedTypes::component>::GetID()]);
+					}
+				} (), ...);
+
+				// Move members to the front of every owned pool, in the same order
+				m_PartitionPools(owned_pools, members);
+
+				new_group->start_index = 0;
+				new_group->end_index = static_cast<ECS_SIZE_TYPE>(members.size());
+			}
+			else {
+				for (const Entity& entity : members) {
+					new_group->AddMember(entity);
 				}
 			}
 
@@ -353,6 +777,8 @@ namespace ECS {
 				}
 			}
 
+			std::erase(m_NonOwningGroups, group.m_GroupData);
+
 			group.m_GroupData = nullptr;
 		}
 
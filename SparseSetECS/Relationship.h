@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Core.h"
+#include "Entity.h"
+
+namespace ECS {
+	// Built-in parent/child links, managed through Registry::SetParent
+	// The registry keeps this pool depth first, each subtree is one block starting at its root (see Registry::SetParent)
+	struct Relationship {
+		Entity parent = null_entity;
+		Entity first_child = null_entity;
+		Entity next_sibling = null_entity;
+		Entity prev_sibling = null_entity;
+		ECS_SIZE_TYPE children = 0;
+		ECS_SIZE_TYPE descendants = 0; // Size of our block in the pool, minus ourself
+	};
+}
@@ -0,0 +1,57 @@
+#include "RuntimeView.h"
+
+namespace ECS {
+	RuntimeView::RuntimeView(Registry* registry, std::span<const ECS_COMP_ID_TYPE> include, std::span<const ECS_COMP_ID_TYPE> exclude)
+		: m_Registry(registry)
+	{
+		if (include.empty()) {
+			LogError("Runtime view needs at least one component to include");
+
+			return;
+		}
+
+		if (include.size() > ECS_MAX_COMPONENTS) {
+			LogError("Runtime view can include at most {} components", ECS_MAX_COMPONENTS);
+
+			return;
+		}
+
+		bool registered = true;
+
+		for (const ECS_COMP_ID_TYPE& id : include) {
+			if (id >= ECS_MAX_COMPONENTS) {
+				LogError("Component id {} is out of range, runtime view will be empty", id);
+
+				return;
+			}
+
+			ComponentPool* pool = registry->m_Pools[id];
+
+			// Nobody can have a component that has never been registered
+			if (pool == nullptr) { registered = false; }
+
+			m_Include.set(id, true);
+			m_Pools.push_back(pool);
+		}
+
+		for (const ECS_COMP_ID_TYPE& id : exclude) {
+			if (id >= ECS_MAX_COMPONENTS) {
+				LogError("Component id {} is out of range, runtime view will be empty", id);
+
+				return;
+			}
+
+			m_Exclude.set(id, true);
+		}
+
+		if (!registered) return;
+
+		// Fewest entities to check
+		for (std::size_t slot = 0; slot < m_Pools.size(); slot++) {
+			if (m_Driver == nullptr || m_Pools[slot]->GetSize() < m_Driver->GetSize()) {
+				m_Driver = m_Pools[slot];
+				m_DriverSlot = slot;
+			}
+		}
+	}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Registry.h"
+
+namespace ECS {
+	// View over components picked at runtime by id (for scripting layers), made by Registry::CreateRuntimeView
+	// Walks the smallest included pool, and checks each entity's signature against masks made once up front
+	// Components are handed out as raw pointers, in the order their ids were given in
+	class RuntimeView {
+	private:
+		Registry* m_Registry;
+		std::vector<ComponentPool*> m_Pools; // One per included id
+		ComponentPool* m_Driver = nullptr; // Smallest of m_Pools, nullptr when nothing can match
+		std::size_t m_DriverSlot = 0; // Position of m_Driver in m_Pools
+		Signature m_Include;
+		Signature m_Exclude;
+
+		inline bool m_Matches(const Entity& entity) const {
+			const Signature& signature = m_Registry->m_Signatures[GetIdentifier(entity)];
+
+			return (signature & m_Include) == m_Include && (signature & m_Exclude).none();
+		}
+
+		// Both Each, Byte is const std::byte for the read-only one, which doesn't touch any slot (see ComponentPool::m_Touch)
+		template <typename Byte, typename Func>
+		void m_Each(Func&& func) const {
+			if (m_Driver == nullptr) return;
+
+			ECS_TRACE_ZONE("RuntimeView::Each");
+
+			constexpr bool writable = !std::is_const_v<Byte>;
+
+			std::array<Byte*, ECS_MAX_COMPONENTS> components{};
+			std::size_t size_in_bytes = m_Driver->m_Allocator->SizeInBytes();
+
+			// Every component may be written to through the pointers
+			if constexpr (writable) { m_Driver->m_TouchRange(0, m_Driver->GetSize()); }
+
+			for (ECS_SIZE_TYPE index = 0; index < m_Driver->GetSize(); index++) {
+				const Entity& entity = m_Driver->m_PackedArray[index];
+
+				if (IsTombstone(entity) || !m_Matches(entity)) continue;
+
+				for (std::size_t slot = 0; slot < m_Pools.size(); slot++) {
+					if (slot == m_DriverSlot) { components[slot] = m_Driver->m_ComponentArray.data + index * size_in_bytes; }
+					else if constexpr (writable) { components[slot] = m_Pools[slot]->m_GetRawForEntity(entity); }
+					else { components[slot] = m_Pools[slot]->m_ReadRawForEntity(entity); }
+				}
+
+				func(entity, components.data());
+			}
+		}
+
+	public:
+		// Iterates matching entities, use Get for their components
+		struct Iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = Entity;
+			using pointer = const Entity*;
+			using reference = const Entity&;
+
+		private:
+			const RuntimeView* m_View = nullptr;
+			const Entity* m_Current = nullptr;
+			const Entity* m_Last = nullptr;
+
+			void m_SkipMismatches() {
+				while (m_Current != m_Last && (IsTombstone(*m_Current) || !m_View->m_Matches(*m_Current))) {
+					++m_Current;
+				}
+			}
+
+		public:
+			Iterator() = default;
+			Iterator(const RuntimeView* view, const Entity* current, const Entity* last)
+				: m_View(view), m_Current(current), m_Last(last)
+			{
+				m_SkipMismatches();
+			}
+
+			reference operator*() const { return *m_Current; }
+			pointer operator->() const { return m_Current; }
+
+			Iterator& operator++() {
+				++m_Current;
+
+				m_SkipMismatches();
+
+				return *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator tmp = *this;
+				++(*this);
+
+				return tmp;
+			}
+
+			friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_Current == b.m_Current; }
+		};
+
+		RuntimeView(Registry* registry, std::span<const ECS_COMP_ID_TYPE> include, std::span<const ECS_COMP_ID_TYPE> exclude = {});
+
+		Iterator begin() const {
+			if (m_Driver == nullptr) return Iterator();
+
+			const Entity* first = m_Driver->m_PackedArray.data;
+
+			return Iterator(this, first, first + m_Driver->GetSize());
+		}
+
+		Iterator end() const {
+			if (m_Driver == nullptr) return Iterator();
+
+			const Entity* last = m_Driver->m_PackedArray.data + m_Driver->GetSize();
+
+			return Iterator(this, last, last);
+		}
+
+		// Component of the slot'th included id for entity, which has to be in the view (read only, Each hands out writable ones)
+		const std::byte* Get(const Entity& entity, const std::size_t& slot) const { return m_Pools[slot]->m_ReadRawForEntity(entity); }
+
+		bool Contains(const Entity& entity) const { return m_Driver != nullptr && m_Matches(entity); }
+
+		// Most entities the view can have (the size of its smallest pool)
+		ECS_SIZE_TYPE SizeHint() const { return m_Driver != nullptr ? m_Driver->GetSize() : 0; }
+
+		// Call func(entity, components) for every match, components[slot] being the component of the slot'th included id
+		// Faster than iterating, the smallest pool's components are found by position instead of being looked up
+		template <typename Func>
+		void Each(Func&& func) { m_Each<std::byte>(std::forward<Func>(func)); }
+
+		// Same on a const view (std::as_const), components are const std::byte* and reading them doesn't count as writing
+		template <typename Func>
+		void Each(Func&& func) const { m_Each<const std::byte>(std::forward<Func>(func)); }
+	};
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "Core.h"
+#include "Entity.h"
+
+namespace ECS {
+	typedef ECS_SIZE_TYPE SharedHandle_t;
+
+	// Shared values are deduplicated by hash, so they have to be hashable and comparable
+	template <typename T>
+	concept IsShareable = requires (const T& a, const T& b) {
+		{ std::hash<T>{}(a) } -> std::convertible_to<std::size_t>;
+		{ a == b } -> std::convertible_to<bool>;
+	};
+
+	// What actually lives in the packed slot of an entity, instead of a full copy of T
+	template <typename T>
+	struct Shared {
+		SharedHandle_t handle;
+	};
+
+	// Base for the shared value tables, so the registry can release handles without knowing T
+	class SharedTableBase {
+	public:
+		virtual ~SharedTableBase() = default;
+
+		virtual void AddReference(const SharedHandle_t& handle, ECS_SIZE_TYPE count) = 0;
+		virtual void Release(const SharedHandle_t& handle) = 0;
+		virtual void Clear() = 0;
+
+		// Empty table for the same type, for another registry
+		virtual SharedTableBase* CloneEmpty() const = 0;
+		// Copy of the table as it is now, for forks (values never change, so the copy shares them)
+		virtual SharedTableBase* Snapshot() const = 0;
+		// Acquire a copy of the value behind handle in another table of the same type
+		virtual SharedHandle_t CopyInto(const SharedHandle_t& handle, SharedTableBase* other) const = 0;
+
+		// Component id of Shared<T>, the component that stores handles into this table
+		virtual ECS_COMP_ID_TYPE GetHandleID() const = 0;
+	};
+
+	// Deduplicated, reference counted table of values of type T
+	template <IsShareable T>
+	class SharedTable final : public SharedTableBase {
+	private:
+		struct Entry {
+			std::shared_ptr<T> value = nullptr; // Heap allocated so pointers survive the table growing, and being restored from a fork
+			std::size_t hash = 0;
+			ECS_SIZE_TYPE references = 0;
+		};
+
+		std::vector<Entry> m_Entries;
+		std::vector<SharedHandle_t> m_FreeHandles; // Handles of entries with no references, for re-use
+		std::unordered_multimap<std::size_t, SharedHandle_t> m_Lookup; // Hash of value to handle
+
+		ECS_COMP_ID_TYPE m_HandleID = 0;
+
+	public:
+		SharedTable(const ECS_COMP_ID_TYPE& handle_id) : m_HandleID(handle_id) {}
+
+		// Get handle for a value equal to this one, inserting it if we don't have one yet
+		SharedHandle_t Acquire(T&& value) {
+			std::size_t hash = std::hash<T>{}(value);
+
+			// Look for an existing value that is equal to this one
+			auto [first, last] = m_Lookup.equal_range(hash);
+
+			for (auto it = first; it != last; ++it) {
+				Entry& entry = m_Entries[it->second];
+
+				if (*entry.value == value) {
+					++entry.references;
+
+					return it->second;
+				}
+			}
+
+			// No existing value, so find a slot for a new one
+			SharedHandle_t handle;
+
+			if (!m_FreeHandles.empty()) {
+				handle = m_FreeHandles.back();
+				m_FreeHandles.pop_back();
+			}
+			else {
+				handle = static_cast<SharedHandle_t>(m_Entries.size());
+				m_Entries.emplace_back();
+			}
+
+			Entry& entry = m_Entries[handle];
+			entry.value = std::make_shared<T>(std::move(value));
+			entry.hash = hash;
+			entry.references = 1;
+
+			m_Lookup.emplace(hash, handle);
+
+			return handle;
+		}
+
+		void AddReference(const SharedHandle_t& handle, ECS_SIZE_TYPE count) override final {
+			m_Entries[handle].references += count;
+		}
+
+		void Release(const SharedHandle_t& handle) override final {
+			Entry& entry = m_Entries[handle];
+
+			if (entry.references == 0) {
+				LogError("Attempted to release shared value {} of {}, but it had no references", handle, typeid(T).name());
+
+				return;
+			}
+
+			// Still in use by other entities
+			if (--entry.references > 0) return;
+
+			// Remove from lookup
+			auto [first, last] = m_Lookup.equal_range(entry.hash);
+
+			for (auto it = first; it != last; ++it) {
+				if (it->second == handle) { m_Lookup.erase(it); break; }
+			}
+
+			// Destroy the value and make slot available again
+			entry.value = nullptr;
+			m_FreeHandles.push_back(handle);
+		}
+
+		void Clear() override final {
+			m_Entries.clear();
+			m_FreeHandles.clear();
+			m_Lookup.clear();
+		}
+
+		SharedTableBase* CloneEmpty() const override final {
+			return new SharedTable<T>(m_HandleID);
+		}
+
+		SharedTableBase* Snapshot() const override final {
+			return new SharedTable<T>(*this);
+		}
+
+		SharedHandle_t CopyInto(const SharedHandle_t& handle, SharedTableBase* other) const override final {
+			if constexpr (std::is_copy_constructible_v<T>) {
+				return static_cast<SharedTable<T>*>(other)->Acquire(T(*m_Entries[handle].value));
+			}
+			else {
+				LogFatal("Attempted to copy shared value of {}, but no available constructor", typeid(T).name());
+			}
+		}
+
+		ECS_COMP_ID_TYPE GetHandleID() const override final { return m_HandleID; }
+
+		const T* GetValue(const SharedHandle_t& handle) const { return m_Entries[handle].value.get(); }
+		ECS_SIZE_TYPE GetReferences(const SharedHandle_t& handle) const { return m_Entries[handle].references; }
+
+		// Amount of handles ever allocated (including ones currently free)
+		ECS_SIZE_TYPE GetCapacity() const { return static_cast<ECS_SIZE_TYPE>(m_Entries.size()); }
+		// Amount of distinct values currently stored
+		ECS_SIZE_TYPE GetSize() const { return GetCapacity() - static_cast<ECS_SIZE_TYPE>(m_FreeHandles.size()); }
+	};
+}
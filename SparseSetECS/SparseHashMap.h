@@ -0,0 +1,131 @@
+#pragma once
+
+#include <bit>
+
+#include "Core.h"
+#include "Entity.h"
+
+namespace ECS {
+	// Entity identifier to packed index, for pools of rare components (StoragePolicy::Hashed)
+	// Open addressing with linear probing, memory grows with the amount of entries rather than the largest identifier
+	class SparseHashMap {
+	private:
+		struct Slot {
+			Identifier_t key = dead_entity; // dead_entity marks an empty slot (identifiers never reach it)
+			ECS_SIZE_TYPE value = dead_entity;
+		};
+
+		std::vector<Slot> m_Slots; // Always a power of two in size (or empty)
+		ECS_SIZE_TYPE m_Count = 0;
+
+		// Fibonacci hashing, identifiers are mostly sequential so spread them out
+		inline std::size_t m_Home(const Identifier_t& key) const {
+			return (static_cast<std::size_t>(key) * 0x9E3779B97F4A7C15ULL) >> (64 - std::countr_zero(m_Slots.size()));
+		}
+
+		inline std::size_t m_Mask() const { return m_Slots.size() - 1; }
+
+		void m_Grow() {
+			std::vector<Slot> old_slots = std::move(m_Slots);
+
+			m_Slots.assign(old_slots.empty() ? ECS_SPARSE_HASH_MIN : old_slots.size() * 2, Slot{});
+			m_Count = 0;
+
+			for (const Slot& slot : old_slots) {
+				if (slot.key != dead_entity) { Set(slot.key, slot.value); }
+			}
+		}
+
+	public:
+		SparseHashMap() = default;
+		SparseHashMap(const SparseHashMap& other) = delete;
+		SparseHashMap(SparseHashMap&& other) noexcept
+			: m_Slots(std::move(other.m_Slots)), m_Count(other.m_Count)
+		{
+			other.m_Slots.clear();
+			other.m_Count = 0;
+		}
+
+		SparseHashMap& operator=(const SparseHashMap& other) = delete;
+		SparseHashMap& operator=(SparseHashMap&& other) noexcept {
+			m_Slots = std::move(other.m_Slots);
+			m_Count = other.m_Count;
+
+			other.m_Slots.clear();
+			other.m_Count = 0;
+
+			return *this;
+		}
+
+		// Packed index of key, dead_entity if it isn't in here
+		inline ECS_SIZE_TYPE Find(const Identifier_t& key) const {
+			if (m_Count == 0) return dead_entity;
+
+			for (std::size_t index = m_Home(key); ; index = (index + 1) & m_Mask()) {
+				const Slot& slot = m_Slots[index];
+
+				if (slot.key == key) return slot.value;
+				if (slot.key == dead_entity) return dead_entity;
+			}
+		}
+
+		void Set(const Identifier_t& key, const ECS_SIZE_TYPE& value) {
+			// Keep load under 3/4 so probes stay short
+			if ((m_Count + 1) * 4 > m_Slots.size() * 3) { m_Grow(); }
+
+			for (std::size_t index = m_Home(key); ; index = (index + 1) & m_Mask()) {
+				Slot& slot = m_Slots[index];
+
+				if (slot.key == key) {
+					slot.value = value;
+
+					return;
+				}
+
+				if (slot.key == dead_entity) {
+					slot.key = key;
+					slot.value = value;
+					++m_Count;
+
+					return;
+				}
+			}
+		}
+
+		void Erase(const Identifier_t& key) {
+			if (m_Count == 0) return;
+
+			std::size_t index = m_Home(key);
+
+			while (m_Slots[index].key != key) {
+				if (m_Slots[index].key == dead_entity) return;
+
+				index = (index + 1) & m_Mask();
+			}
+
+			// Shift later entries of the probe sequence back into the hole, so lookups never need tombstones
+			std::size_t hole = index;
+
+			for (std::size_t next = (hole + 1) & m_Mask(); m_Slots[next].key != dead_entity; next = (next + 1) & m_Mask()) {
+				std::size_t home = m_Home(m_Slots[next].key);
+
+				// Entry can move back if the hole lies between its home and where it is now
+				if (((next - home) & m_Mask()) >= ((next - hole) & m_Mask())) {
+					m_Slots[hole] = m_Slots[next];
+					hole = next;
+				}
+			}
+
+			m_Slots[hole] = Slot{};
+			--m_Count;
+		}
+
+		void Clear() {
+			std::fill(m_Slots.begin(), m_Slots.end(), Slot{});
+			m_Count = 0;
+		}
+
+		ECS_SIZE_TYPE GetCount() const { return m_Count; }
+		std::size_t GetSizeInBytes() const { return m_Slots.size() * sizeof(Slot); }
+	};
+}
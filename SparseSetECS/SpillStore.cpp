@@ -0,0 +1,45 @@
+#include "SpillStore.h"
+
+namespace ECS {
+	bool SpillStore::Open(const std::string& path)
+	{
+		if (m_File.is_open()) { m_File.close(); }
+
+		m_File.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		m_End = 0;
+		m_Records.clear();
+
+		return m_File.is_open();
+	}
+
+	bool SpillStore::Append(const std::byte* data, const std::size_t& size, std::uint64_t& offset)
+	{
+		m_File.clear();
+		m_File.seekp(static_cast<std::streamoff>(m_End));
+		m_File.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+		m_File.flush();
+
+		if (!m_File) return false;
+
+		offset = m_End;
+		m_End += size;
+
+		return true;
+	}
+
+	bool SpillStore::Read(const std::uint64_t& offset, std::byte* data, const std::size_t& size)
+	{
+		m_File.clear();
+		m_File.seekg(static_cast<std::streamoff>(offset));
+		m_File.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+
+		return static_cast<bool>(m_File);
+	}
+
+	const SpillStore::Record* SpillStore::Find(const Entity& entity) const
+	{
+		auto it = m_Records.find(entity);
+
+		return it != m_Records.end() ? &it->second : nullptr;
+	}
+}
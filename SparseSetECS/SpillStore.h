@@ -0,0 +1,48 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include "Core.h"
+#include "Entity.h"
+
+namespace ECS {
+	// Append-only file that evicted entities are written to (see Registry::Evict), with an index of where each one is
+	// A record is the entity, its signature, then the bytes of each of its components in order of component id
+	// Restored records aren't reused, the file only shrinks when it's opened again
+	class SpillStore {
+	public:
+		struct Record {
+			std::uint64_t offset = 0;	// Start of the record in the file
+			std::uint32_t size = 0;		// Including the header
+			Signature signature;		// Components the entity had when evicted
+		};
+
+		// Entity followed by the bytes of its signature, at the start of every record
+		static constexpr std::size_t header_size = sizeof(Entity) + sizeof(Signature);
+
+	private:
+		std::fstream m_File;
+		std::uint64_t m_End = 0;
+		std::unordered_map<Entity, Record> m_Records;
+
+	public:
+		// Create (or truncate) the file at path, forgetting every record
+		bool Open(const std::string& path);
+		bool IsOpen() const { return m_File.is_open(); }
+
+		// Write size bytes at the end of the file, offset is where they start
+		bool Append(const std::byte* data, const std::size_t& size, std::uint64_t& offset);
+		bool Read(const std::uint64_t& offset, std::byte* data, const std::size_t& size);
+
+		// nullptr if entity isn't evicted
+		const Record* Find(const Entity& entity) const;
+		void Insert(const Entity& entity, const Record& record) { m_Records[entity] = record; }
+		void Erase(const Entity& entity) { m_Records.erase(entity); }
+		// Forget every record, the file is left as it is
+		void Clear() { m_Records.clear(); }
+
+		std::size_t GetCount() const { return m_Records.size(); }
+	};
+}
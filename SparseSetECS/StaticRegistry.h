@@ -0,0 +1,90 @@
+#pragma once
+
+#include "View.h"
+#include "Group.h"
+
+namespace ECS {
+	// Registry for a component set fixed at compile time, every pool is registered up front
+	// Lookups of the listed components skip the type id guard, the pool array and the null check,
+	// everything else (groups, views, indexes, forks) is the normal Registry
+	template <typename... Components>
+	class StaticRegistry : public Registry {
+	private:
+		static_assert(sizeof...(Components) <= ECS_MAX_COMPONENTS, "Too many components for one registry");
+
+		template <typename T>
+		static constexpr bool m_Listed = (std::is_same_v<T, Components> || ...);
+
+		// Position of T in Components, at compile time
+		template <typename T>
+		static constexpr std::size_t m_Position() {
+			static_assert(m_Listed<T>, "Component isn't part of this StaticRegistry");
+
+			std::size_t position = 0;
+			std::size_t index = 0;
+
+			((std::is_same_v<T, Components> ? (position = index, ++index) : ++index), ...);
+
+			return position;
+		}
+
+		std::array<ComponentPool*, sizeof...(Components)> m_StaticPools;
+		std::array<ECS_COMP_ID_TYPE, sizeof...(Components)> m_StaticIDs;
+
+		template <typename T>
+		inline ComponentPool* m_Pool() const { return m_StaticPools[m_Position<T>()]; }
+
+	public:
+		StaticRegistry(ECS_SIZE_TYPE default_capacity = 1000)
+			: Registry(default_capacity)
+		{
+			(RegisterComponent<Components>(), ...);
+
+			m_StaticPools = { m_Pools[ComponentAllocator<Components>::GetID()]... };
+			m_StaticIDs = { ComponentAllocator<Components>::GetID()... };
+		}
+
+		// Index of T's bit in signatures
+		template <typename T>
+		inline ECS_COMP_ID_TYPE GetID() const {
+			if constexpr (!m_Listed<T>) return ComponentAllocator<T>::GetID();
+			else return m_StaticIDs[m_Position<T>()];
+		}
+
+		// Components not in the list go through the normal Registry path
+		template <typename T> T* GetComponent(const Entity& entity) {
+			if constexpr (!m_Listed<T>) return Registry::GetComponent<T>(entity);
+			else return m_Pool<T>()->template GetComponentForEntity<T>(entity);
+		}
+
+		template <typename T>
+		bool HasComponent(const Entity& entity) {
+			if constexpr (!m_Listed<T>) return Registry::HasComponent<T>(entity);
+			else return m_Signatures[GetIdentifier(entity)].test(GetID<T>());
+		}
+
+		template <typename... Ts>
+		bool AnyOf(const Entity& entity) {
+			if constexpr (!(m_Listed<Ts> && ...)) return Registry::AnyOf<Ts...>(entity);
+			else return (HasComponent<Ts>(entity) || ...);
+		}
+
+		template <typename... Ts>
+		bool AllOf(const Entity& entity) {
+			if constexpr (!(m_Listed<Ts> && ...)) return Registry::AllOf<Ts...>(entity);
+			else return (HasComponent<Ts>(entity) && ...);
+		}
+
+		template <typename... Ts>
+		std::tuple<Ts*...> GetComponents(const Entity& entity) {
+			if constexpr (!(m_Listed<Ts> && ...)) return Registry::GetComponents<Ts...>(entity);
+			else return std::make_tuple<Ts*...>(GetComponent<Ts>(entity)...);
+		}
+
+		template <typename T>
+		SingleView<T> CreateSingleView() {
+			if constexpr (!m_Listed<std::remove_const_t<T>>) return Registry::CreateSingleView<T>();
+			else return SingleView<T>(m_Pool<std::remove_const_t<T>>());
+		}
+	};
+}
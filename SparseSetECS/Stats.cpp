@@ -0,0 +1,27 @@
+#include "Stats.h"
+
+#include <format>
+
+namespace ECS {
+	std::string PoolStats::ToJson() const {
+		return std::format(
+			"{{\"id\":{},\"size\":{},\"capacity\":{},\"tombstones\":{},\"bytes_reserved\":{},\"bytes_used\":{},\"sparse_pages\":{},\"resizes\":{},\"swaps\":{}}}",
+			id, size, capacity, tombstones, bytes_reserved, bytes_used, sparse_pages, resizes, swaps
+		);
+	}
+
+	std::string RegistryStats::ToJson() const {
+		std::string pools_json;
+
+		for (const PoolStats& pool : pools) {
+			if (!pools_json.empty()) { pools_json += ","; }
+
+			pools_json += pool.ToJson();
+		}
+
+		return std::format(
+			"{{\"entities_alive\":{},\"entities_created\":{},\"entities_recycled\":{},\"emplace_calls\":{},\"group_swaps\":{},\"group_swaps_per_emplace\":{},\"bytes_reserved\":{},\"bytes_used\":{},\"signature_pages\":{},\"pools\":[{}]}}",
+			entities_alive, entities_created, entities_recycled, emplace_calls, group_swaps, GroupSwapsPerEmplace(), bytes_reserved, bytes_used, signature_pages, pools_json
+		);
+	}
+}
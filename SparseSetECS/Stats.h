@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+
+#include "Core.h"
+
+namespace ECS {
+	// Snapshot of what a single component pool is doing
+	struct PoolStats {
+		ECS_COMP_ID_TYPE id = 0;
+
+		ECS_SIZE_TYPE size = 0;			// Includes tombstones
+		ECS_SIZE_TYPE capacity = 0;
+		ECS_SIZE_TYPE tombstones = 0;
+
+		std::size_t bytes_reserved = 0;	// Packed and component arrays at capacity, plus resident sparse pages (or the hash map)
+		std::size_t bytes_used = 0;		// Packed and component arrays at size
+		ECS_SIZE_TYPE sparse_pages = 0;	// Sparse pages currently allocated, always 0 for hashed pools
+
+		std::uint64_t resizes = 0;
+		std::uint64_t swaps = 0;
+
+		std::string ToJson() const;
+	};
+
+	// Snapshot of the registry, and every registered pool
+	struct RegistryStats {
+		ECS_SIZE_TYPE entities_alive = 0;
+		std::uint64_t entities_created = 0;		// Freshly created identifiers
+		std::uint64_t entities_recycled = 0;	// Identifiers re-used after being freed
+
+		std::uint64_t emplace_calls = 0;		// Calls to EmplaceComponent/AddComponent
+		std::uint64_t group_swaps = 0;			// Swaps done to keep owning groups packed
+
+		std::size_t bytes_reserved = 0;
+		std::size_t bytes_used = 0;
+		ECS_SIZE_TYPE signature_pages = 0;
+
+		std::vector<PoolStats> pools;
+
+		double GroupSwapsPerEmplace() const {
+			return emplace_calls == 0 ? 0.0 : static_cast<double>(group_swaps) / static_cast<double>(emplace_calls);
+		}
+
+		std::string ToJson() const;
+	};
+}
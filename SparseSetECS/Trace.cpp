@@ -0,0 +1,125 @@
+#include "Trace.h"
+
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <mutex>
+
+namespace ECS {
+	namespace Trace {
+		// Buffers live until exit, a finished thread's buffer is handed to the next new thread once its events have been dumped
+		static std::mutex s_BuffersMutex;
+		static std::vector<std::unique_ptr<ThreadBuffer>> s_Buffers;
+		static std::vector<ThreadBuffer*> s_RetiredBuffers; // Thread finished, events not dumped yet
+		static std::vector<ThreadBuffer*> s_FreeBuffers; // Dumped and emptied, ready for another thread
+
+		// Gives the thread's buffer back when the thread exits
+		struct BufferLease {
+			ThreadBuffer* buffer = nullptr;
+
+			~BufferLease() {
+				if (buffer == nullptr) return;
+
+				std::lock_guard<std::mutex> lock(s_BuffersMutex);
+
+				s_RetiredBuffers.push_back(buffer);
+			}
+		};
+
+		ThreadBuffer& GetThreadBuffer() {
+			thread_local BufferLease lease;
+
+			// Only locks the first time a thread records something
+			if (lease.buffer == nullptr) {
+				std::lock_guard<std::mutex> lock(s_BuffersMutex);
+
+				if (!s_FreeBuffers.empty()) {
+					lease.buffer = s_FreeBuffers.back();
+					s_FreeBuffers.pop_back();
+				}
+				else {
+					s_Buffers.push_back(std::make_unique<ThreadBuffer>());
+					lease.buffer = s_Buffers.back().get();
+					lease.buffer->thread_id = static_cast<std::uint32_t>(s_Buffers.size());
+				}
+			}
+
+			return *lease.buffer;
+		}
+
+		std::int64_t Now() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		void Record(const char* name, std::int64_t start, std::int64_t end) {
+			ThreadBuffer& buffer = GetThreadBuffer();
+			std::uint64_t written = buffer.written.load(std::memory_order_relaxed);
+
+			buffer.events[written % ECS_TRACE_BUFFER_SIZE] = Event{ name, start, end };
+
+			// Publish event to DumpChromeTrace
+			buffer.written.store(written + 1, std::memory_order_release);
+		}
+
+		bool DumpChromeTrace(const std::string& path) {
+			std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+			if (!file.is_open()) {
+				LogError("Couldn't open {} to write trace", path);
+
+				return false;
+			}
+
+			file << "{\"traceEvents\":[";
+
+			bool first_event = true;
+
+			std::lock_guard<std::mutex> lock(s_BuffersMutex);
+
+			for (const std::unique_ptr<ThreadBuffer>& buffer : s_Buffers) {
+				std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+				std::uint64_t first = written > ECS_TRACE_BUFFER_SIZE ? written - ECS_TRACE_BUFFER_SIZE : 0;
+
+				std::vector<Event> events;
+				events.reserve(written - first);
+
+				for (std::uint64_t index = first; index < written; index++) {
+					events.push_back(buffer->events[index % ECS_TRACE_BUFFER_SIZE]);
+				}
+
+				// The owning thread may have kept recording while we copied, so drop anything it could have overwritten
+				// Including the slot of event written_after, which it may be in the middle of writing
+				// The fence keeps the copies above from being reordered past this re-check (as in a seqlock)
+				std::atomic_thread_fence(std::memory_order_acquire);
+				std::uint64_t written_after = buffer->written.load(std::memory_order_relaxed);
+				std::uint64_t overwritten = written_after + 1 > ECS_TRACE_BUFFER_SIZE ? written_after + 1 - ECS_TRACE_BUFFER_SIZE : 0;
+				std::uint64_t skip = overwritten > first ? std::min<std::uint64_t>(overwritten - first, events.size()) : 0;
+
+				for (std::size_t index = skip; index < events.size(); index++) {
+					const Event& event = events[index];
+
+					if (!first_event) { file << ","; }
+					first_event = false;
+
+					// Chrome expects microseconds
+					file << std::format(
+						"{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+						event.name, buffer->thread_id, event.start / 1000.0, (event.end - event.start) / 1000.0
+					);
+				}
+			}
+
+			file << "]}";
+
+			// Finished threads' events are out, their buffers can be reused (emptied so they aren't dumped again)
+			for (ThreadBuffer* buffer : s_RetiredBuffers) {
+				buffer->written.store(0, std::memory_order_relaxed);
+				s_FreeBuffers.push_back(buffer);
+			}
+
+			s_RetiredBuffers.clear();
+
+			return true;
+		}
+	}
+}
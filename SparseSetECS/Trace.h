@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Core.h"
+
+namespace ECS {
+	namespace Trace {
+		struct Event {
+			const char* name = nullptr; // Must be a string literal (or otherwise outlive the dump)
+			std::int64_t start = 0;		// Nanoseconds
+			std::int64_t end = 0;
+		};
+
+		// Ring buffer only ever written by the thread that owns it, so recording doesn't need locks
+		struct ThreadBuffer {
+			std::array<Event, ECS_TRACE_BUFFER_SIZE> events;
+			std::atomic<std::uint64_t> written = 0;
+			std::uint32_t thread_id = 0;
+		};
+
+		// Buffer for the calling thread, registered on first use (reusing a finished thread's once DumpChromeTrace has written it)
+		ThreadBuffer& GetThreadBuffer();
+
+		std::int64_t Now();
+
+		void Record(const char* name, std::int64_t start, std::int64_t end);
+
+		// Write every thread's buffered events in the Chrome trace event format (also loads in Perfetto)
+		bool DumpChromeTrace(const std::string& path);
+
+		class ScopedZone {
+		private:
+			const char* m_Name;
+			std::int64_t m_Start;
+
+		public:
+			ScopedZone(const char* name) : m_Name(name), m_Start(Now()) {}
+			~ScopedZone() { Record(m_Name, m_Start, Now()); }
+
+			ScopedZone(const ScopedZone&) = delete;
+			ScopedZone& operator=(const ScopedZone&) = delete;
+		};
+	}
+}
+
+#if ECS_ENABLE_TRACING
+#define ECS_TRACE_CONCAT_IMPL(a, b) a##b
+#define ECS_TRACE_CONCAT(a, b) ECS_TRACE_CONCAT_IMPL(a, b)
+#define ECS_TRACE_ZONE(name) ::ECS::Trace::ScopedZone ECS_TRACE_CONCAT(__ecs_trace_zone_, __LINE__)(name)
+#else
+#define ECS_TRACE_ZONE(name)
+#endif
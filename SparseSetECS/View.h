@@ -3,31 +3,59 @@
 #include "Registry.h"
 
 namespace ECS {
+	// SingleView<const T> only reads, so iterating it doesn't count as writing to T (see ComponentPool::m_Touch)
 	template <typename T>
 	class SingleView {
 	private:
+		using Component = std::remove_const_t<T>;
+
 		ComponentPool* m_Pool;
 
+		// Without tombstones to skip, the components are one contiguous array
+		static constexpr bool m_Contiguous = !ComponentTraits<Component>::in_place_delete;
+
 	public:
 		struct Iterator {
 		public:
-			using iterator_category = std::forward_iterator_tag;
+			using iterator_concept = std::conditional_t<m_Contiguous, std::contiguous_iterator_tag, std::forward_iterator_tag>;
+			using iterator_category = std::conditional_t<m_Contiguous, std::random_access_iterator_tag, std::forward_iterator_tag>;
 			using difference_type = std::ptrdiff_t;
 			using value_type = T;
+			using element_type = T;
 			using pointer = value_type*;
 			using reference = value_type&;
 
 		private:
-			pointer m_Current;
+			pointer m_Current = nullptr;
+			// Packed entities, only looked at to skip tombstones when T uses in-place deletion
+			const Entity* m_Entity = nullptr;
+			const Entity* m_Last = nullptr;
+
+			void m_SkipTombstones() {
+				if constexpr (ComponentTraits<Component>::in_place_delete) {
+					while (m_Entity != m_Last && IsTombstone(*m_Entity)) {
+						++m_Current;
+						++m_Entity;
+					}
+				}
+			}
 
 		public:
-			Iterator(pointer ptr) : m_Current(ptr) {}
+			Iterator() = default;
+			Iterator(pointer ptr, const Entity* entity, const Entity* last)
+				: m_Current(ptr), m_Entity(entity), m_Last(last)
+			{
+				m_SkipTombstones();
+			}
 
 			reference operator*() const { return *m_Current; }
-			pointer operator->() { return m_Current; }
+			pointer operator->() const { return m_Current; }
 
 			Iterator& operator++() {
 				m_Current++;
+				m_Entity++;
+
+				m_SkipTombstones();
 
 				return *this;
 			}
@@ -40,17 +68,138 @@ namespace ECS {
 			}
 
 			friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_Current == b.m_Current; }
-			friend bool operator!=(const Iterator& a, const Iterator& b) { return a.m_Current != b.m_Current; }
+
+			// Random access, only when there are no tombstones to skip
+			reference operator[](const difference_type& offset) const requires m_Contiguous { return m_Current[offset]; }
+
+			Iterator& operator--() requires m_Contiguous { m_Current--; m_Entity--; return *this; }
+			Iterator operator--(int) requires m_Contiguous { Iterator tmp = *this; --(*this); return tmp; }
+
+			Iterator& operator+=(const difference_type& offset) requires m_Contiguous { m_Current += offset; m_Entity += offset; return *this; }
+			Iterator& operator-=(const difference_type& offset) requires m_Contiguous { m_Current -= offset; m_Entity -= offset; return *this; }
+
+			friend Iterator operator+(Iterator it, const difference_type& offset) requires m_Contiguous { return it += offset; }
+			friend Iterator operator+(const difference_type& offset, Iterator it) requires m_Contiguous { return it += offset; }
+			friend Iterator operator-(Iterator it, const difference_type& offset) requires m_Contiguous { return it -= offset; }
+			friend difference_type operator-(const Iterator& a, const Iterator& b) requires m_Contiguous { return a.m_Current - b.m_Current; }
+			friend auto operator<=>(const Iterator& a, const Iterator& b) requires m_Contiguous { return a.m_Current <=> b.m_Current; }
 		};
 
 		Iterator begin() {
-			return Iterator(m_Pool->begin<T>().GetPtr());
+			// Every component may be written to through the iterator
+			if constexpr (!std::is_const_v<T>) { m_Pool->m_TouchRange(0, m_Pool->GetSize()); }
+
+			const Entity* last = m_Pool->m_PackedArray.data + m_Pool->GetSize();
+
+			return Iterator(m_Pool->begin<T>().GetPtr(), m_Pool->m_PackedArray.data, last);
 		}
 
 		Iterator end() {
-			return Iterator(m_Pool->end<T>().GetPtr());
+			const Entity* last = m_Pool->m_PackedArray.data + m_Pool->GetSize();
+
+			return Iterator(m_Pool->end<T>().GetPtr(), last, last);
 		}
 
 		SingleView(ComponentPool* pool) : m_Pool(pool) {}
 	};
+
+	// Read-only view over the front buffer of a double-buffered component (see ComponentTraits::double_buffered)
+	// Sees T as it was at the newest Registry::Flip when the view was made, whatever is written or flipped in the meantime
+	// The view pins that buffer until it's destroyed, so make a new one each frame rather than keeping one around
+	template <typename T>
+	class FrontView {
+	private:
+		const ComponentPool* m_Pool = nullptr;
+		const ComponentPool::FrontBuffer* m_Buffer = nullptr; // nullptr if nothing was flipped yet
+
+	public:
+		struct Iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = const T;
+			using pointer = value_type*;
+			using reference = value_type&;
+
+		private:
+			pointer m_Current;
+			// Front entities, empty slots are skipped
+			const Entity* m_Entity;
+			const Entity* m_Last;
+
+			void m_SkipEmpty() {
+				while (m_Entity != m_Last && IsTombstone(*m_Entity)) {
+					++m_Current;
+					++m_Entity;
+				}
+			}
+
+		public:
+			Iterator(pointer ptr, const Entity* entity, const Entity* last)
+				: m_Current(ptr), m_Entity(entity), m_Last(last)
+			{
+				m_SkipEmpty();
+			}
+
+			reference operator*() const { return *m_Current; }
+			pointer operator->() { return m_Current; }
+
+			// Entity the current component belonged to at the flip
+			const Entity& GetEntity() const { return *m_Entity; }
+
+			Iterator& operator++() {
+				m_Current++;
+				m_Entity++;
+
+				m_SkipEmpty();
+
+				return *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator tmp = *this;
+				++(*this);
+
+				return tmp;
+			}
+
+			friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_Entity == b.m_Entity; }
+			friend bool operator!=(const Iterator& a, const Iterator& b) { return a.m_Entity != b.m_Entity; }
+		};
+
+		Iterator begin() const {
+			if (m_Buffer == nullptr) return Iterator(nullptr, nullptr, nullptr);
+
+			const Entity* last = m_Buffer->entities + m_Buffer->size;
+
+			return Iterator(reinterpret_cast<const T*>(m_Buffer->components), m_Buffer->entities, last);
+		}
+
+		Iterator end() const {
+			if (m_Buffer == nullptr) return Iterator(nullptr, nullptr, nullptr);
+
+			const Entity* last = m_Buffer->entities + m_Buffer->size;
+
+			return Iterator(reinterpret_cast<const T*>(m_Buffer->components) + m_Buffer->size, last, last);
+		}
+
+		// Call func(entity, const T&) for every component in the front buffer
+		template <typename Func>
+		void Each(Func&& func) const {
+			for (Iterator it = begin(); it != end(); ++it) {
+				func(it.GetEntity(), *it);
+			}
+		}
+
+		FrontView(ComponentPool* pool) : m_Pool(pool), m_Buffer(pool->m_AcquireFront()) {}
+		~FrontView() {
+			if (m_Buffer != nullptr) { m_Pool->m_ReleaseFront(m_Buffer); }
+		}
+
+		// Only one view releases each pin
+		FrontView(FrontView&& other) noexcept : m_Pool(other.m_Pool), m_Buffer(std::exchange(other.m_Buffer, nullptr)) {}
+		FrontView(const FrontView& other) = delete;
+		FrontView& operator=(const FrontView& other) = delete;
+		FrontView& operator=(FrontView&& other) = delete;
+	};
 }
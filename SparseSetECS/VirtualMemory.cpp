@@ -0,0 +1,75 @@
+#include "VirtualMemory.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ECS::VirtualMemory {
+#if defined(_WIN32)
+	std::size_t GetPageSize() {
+		static const std::size_t page_size = [] {
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+
+			return static_cast<std::size_t>(info.dwPageSize);
+		} ();
+
+		return page_size;
+	}
+
+	void* Reserve(const std::size_t& bytes) {
+		return VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+	}
+
+	bool Commit(void* address, const std::size_t& bytes) {
+		return VirtualAlloc(address, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+	}
+
+	void Decommit(void* address, const std::size_t& bytes) {
+		VirtualFree(address, bytes, MEM_DECOMMIT);
+	}
+
+	void Release(void* address, const std::size_t& bytes) {
+		VirtualFree(address, 0, MEM_RELEASE);
+	}
+
+	// Windows only has large pages through privileged allocations made up front
+	void AdviseHugePages(void* address, const std::size_t& bytes) {}
+#else
+	std::size_t GetPageSize() {
+		static const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+		return page_size;
+	}
+
+	void* Reserve(const std::size_t& bytes) {
+		void* address = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+		return address == MAP_FAILED ? nullptr : address;
+	}
+
+	bool Commit(void* address, const std::size_t& bytes) {
+		return mprotect(address, bytes, PROT_READ | PROT_WRITE) == 0;
+	}
+
+	void Decommit(void* address, const std::size_t& bytes) {
+		// Drop the pages, then make touching them fault again
+		madvise(address, bytes, MADV_DONTNEED);
+		mprotect(address, bytes, PROT_NONE);
+	}
+
+	void Release(void* address, const std::size_t& bytes) {
+		munmap(address, bytes);
+	}
+
+	void AdviseHugePages(void* address, const std::size_t& bytes) {
+#ifdef MADV_HUGEPAGE
+		madvise(address, bytes, MADV_HUGEPAGE);
+#endif
+	}
+#endif
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Core.h"
+
+namespace ECS::VirtualMemory {
+	// Granularity everything below works in, sizes get rounded up to this
+	std::size_t GetPageSize();
+
+	inline std::size_t RoundToPage(const std::size_t& bytes) {
+		std::size_t page_size = GetPageSize();
+
+		return (bytes + page_size - 1) / page_size * page_size;
+	}
+
+	// Reserve address space without backing it with memory, nullptr on failure
+	void* Reserve(const std::size_t& bytes);
+	// Back part of a reservation with memory (zeroed), address and bytes should be page aligned
+	bool Commit(void* address, const std::size_t& bytes);
+	// Give memory back to the OS, the addresses stay reserved
+	void Decommit(void* address, const std::size_t& bytes);
+	// Free the whole reservation
+	void Release(void* address, const std::size_t& bytes);
+
+	// Ask for transparent huge pages over this range, does nothing where that isn't supported
+	void AdviseHugePages(void* address, const std::size_t& bytes);
+}
@@ -1,6 +1,8 @@
 #include "ECS.h"
 
 #include <chrono>
+#include <numeric>
+#include <random>
 
 using namespace ECS;
 
@@ -29,6 +31,165 @@ struct Physics {
         : mass(_0), restitution(_1), is_rigid(_2) {}
 };
 
+struct Health {
+    int value;
+
+    Health(int _0) : value(_0) {}
+};
+
+// Owned group iteration against a group where Position is partial, so each Position goes through the sparse array
+void BenchmarkPartialIteration(int count) {
+    // Add Physics in a random order so the partial lookups aren't sequential
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937{ 42 });
+
+    Registry owned_reg(count);
+    Registry partial_reg(count);
+    owned_reg.RegisterComponent<Position>();
+    owned_reg.RegisterComponent<Physics>();
+    partial_reg.RegisterComponent<Position>();
+    partial_reg.RegisterComponent<Physics>();
+
+    auto owned_group = owned_reg.CreateGroup<Owned<Position>, Owned<Physics>>();
+    auto partial_group = partial_reg.CreateGroup<Partial<Position>, Owned<Physics>>();
+
+    for (Registry* reg : { &owned_reg, &partial_reg }) {
+        std::vector<Entity> entities;
+
+        for (int i = 0; i < count; i++) {
+            Entity e = reg->Create();
+            entities.push_back(e);
+            reg->EmplaceComponent<Position>(e, i, i);
+        }
+
+        for (int i : order) {
+            reg->EmplaceComponent<Physics>(entities[i], 1.0f, 0.5f, true);
+        }
+    }
+
+    float owned_sum = 0.0f;
+    auto owned_start = CURRENT;
+
+    for (auto [entity, position, physics] : owned_group) {
+        owned_sum += physics->mass * position->x;
+    }
+
+    auto owned_time = ELAPSED(owned_start);
+
+    float partial_sum = 0.0f;
+    auto partial_start = CURRENT;
+
+    for (auto [entity, position, physics] : partial_group) {
+        partial_sum += physics->mass * position->x;
+    }
+
+    auto partial_time = ELAPSED(partial_start);
+
+    std::cout << "Owned iteration: " << owned_time << "ms, partial iteration: " << partial_time << "ms (" << owned_sum << ", " << partial_sum << ")" << std::endl;
+}
+
+// Sparse sets against archetype chunks, for creation, a query neither backend is specialised for, and structural changes
+void BenchmarkArchetypes(int count) {
+    Registry sparse_reg(count);
+    ArchetypeRegistry archetype_reg;
+
+    std::vector<Entity> sparse_entities;
+    std::vector<Entity> archetype_entities;
+
+    // Creating entities with two components
+    auto sparse_create_start = CURRENT;
+
+    for (int i = 0; i < count; i++) {
+        Entity e = sparse_reg.Create();
+        sparse_entities.push_back(e);
+        sparse_reg.EmplaceComponent<Position>(e, i, i);
+        sparse_reg.EmplaceComponent<Physics>(e, 1.0f, 0.5f, true);
+    }
+
+    auto sparse_create_time = ELAPSED(sparse_create_start);
+    auto archetype_create_start = CURRENT;
+
+    for (int i = 0; i < count; i++) {
+        Entity e = archetype_reg.Create();
+        archetype_entities.push_back(e);
+        archetype_reg.EmplaceComponent<Position>(e, i, i);
+        archetype_reg.EmplaceComponent<Physics>(e, 1.0f, 0.5f, true);
+    }
+
+    auto archetype_create_time = ELAPSED(archetype_create_start);
+
+    // Give half of them health, so the query spans more than one archetype
+    for (int i = 0; i < count; i += 2) {
+        sparse_reg.EmplaceComponent<Health>(sparse_entities[i], 100);
+        archetype_reg.EmplaceComponent<Health>(archetype_entities[i], 100);
+    }
+
+    // Iterating a combination nothing owns
+    auto sparse_group = sparse_reg.CreateGroup<Partial<Position>, Partial<Physics>>();
+
+    float sparse_sum = 0.0f;
+    auto sparse_iterate_start = CURRENT;
+
+    for (auto [entity, position, physics] : sparse_group) {
+        sparse_sum += physics->mass * position->x;
+    }
+
+    auto sparse_iterate_time = ELAPSED(sparse_iterate_start);
+
+    float archetype_sum = 0.0f;
+    auto archetype_iterate_start = CURRENT;
+
+    archetype_reg.CreateView<Position, Physics>().Each([&](Entity entity, Position& position, Physics& physics) {
+        archetype_sum += physics.mass * position.x;
+    });
+
+    auto archetype_iterate_time = ELAPSED(archetype_iterate_start);
+
+    // Removing and adding back a component on every entity
+    auto sparse_change_start = CURRENT;
+
+    for (Entity e : sparse_entities) {
+        sparse_reg.RemoveComponent<Physics>(e);
+        sparse_reg.EmplaceComponent<Physics>(e, 2.0f, 0.5f, false);
+    }
+
+    auto sparse_change_time = ELAPSED(sparse_change_start);
+    auto archetype_change_start = CURRENT;
+
+    for (Entity e : archetype_entities) {
+        archetype_reg.RemoveComponent<Physics>(e);
+        archetype_reg.EmplaceComponent<Physics>(e, 2.0f, 0.5f, false);
+    }
+
+    auto archetype_change_time = ELAPSED(archetype_change_start);
+
+    std::cout << "Sparse set: create " << sparse_create_time << "ms, iterate " << sparse_iterate_time << "ms, add/remove " << sparse_change_time << "ms (" << sparse_sum << ")" << std::endl;
+    std::cout << "Archetype:  create " << archetype_create_time << "ms, iterate " << archetype_iterate_time << "ms, add/remove " << archetype_change_time << "ms (" << archetype_sum << ")" << std::endl;
+}
+
+// Listed components take the static lookups, anything else falls back to the normal Registry path
+void StaticRegistryExample() {
+    StaticRegistry<Position, Physics> reg;
+    reg.RegisterComponent<Health>();
+
+    Entity e = reg.Create();
+    reg.EmplaceComponent<Position>(e, 1, 2);
+    reg.EmplaceComponent<Physics>(e, 1.0f, 0.5f, true);
+    reg.EmplaceComponent<Health>(e, 100);
+
+    auto [position, health] = reg.GetComponents<Position, Health>(e);
+    bool has_all = reg.AllOf<Position, Physics, Health>(e);
+
+    int total_health = 0;
+
+    for (Health& hp : reg.CreateSingleView<Health>()) {
+        total_health += hp.value;
+    }
+
+    std::cout << "Static registry: position " << position->x << ", " << reg.GetComponent<Physics>(e)->mass << " mass, health " << health->value << ", has all " << has_all << ", total health " << total_health << std::endl;
+}
+
 int main()
 {
     auto t1 = CURRENT;
@@ -49,10 +210,22 @@ int main()
         reg.EmplaceComponent<Physics>(e, 5.0f * z, (float)z, true);
     }
 
-    for (auto& [entity, position, physics] : physics_group) {
-        LogTrace("Entity: {}, is at {}, {}, with mass {}", entity, position->x, position->y, physics->mass);
+    {
+        ECS_TRACE_ZONE("PhysicsSystem");
+
+        for (auto [entity, position, physics] : physics_group) {
+            LogTrace("Entity: {}, is at {}, {}, with mass {}", entity, position->x, position->y, physics->mass);
+        }
     }
 
     auto e1 = ELAPSED(t1);
     LOGTIME(e1);
+
+    BenchmarkPartialIteration(100000);
+    BenchmarkArchetypes(100000);
+    StaticRegistryExample();
+
+#if ECS_ENABLE_TRACING
+    Trace::DumpChromeTrace("trace.json");
+#endif
 }
\ No newline at end of file